@@ -0,0 +1,64 @@
+#include "AllocationCounter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// The replacement operators are kept out of the benchmark's translation
+// unit so that they are not inlined into code whose allocations the
+// compiler would then see freed by a mismatched function.
+
+// Parallel stages allocate from several threads.
+static std::atomic<size_t> count = 0;
+
+void* operator new(size_t size)
+{
+	count.fetch_add(1, std::memory_order_relaxed);
+
+	if (auto* ptr = malloc(size ? size : 1))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	count.fetch_add(1, std::memory_order_relaxed);
+
+	auto align = std::max((size_t)alignment, sizeof(void*));
+	auto roundedSize = (size + align - 1) / align * align;
+
+	if (auto* ptr = aligned_alloc(align, roundedSize ? roundedSize : align))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+	free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+	free(ptr);
+}
+
+namespace hirzel::json
+{
+	size_t allocationCount()
+	{
+		return count.load();
+	}
+}
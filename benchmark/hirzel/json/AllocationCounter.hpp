@@ -0,0 +1,13 @@
+#ifndef HIRZEL_JSON_ALLOCATION_COUNTER_HPP
+#define HIRZEL_JSON_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+namespace hirzel::json
+{
+	// Number of allocations made through the global operator new so far,
+	// by any thread.
+	size_t allocationCount();
+}
+
+#endif
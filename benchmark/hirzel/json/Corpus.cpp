@@ -0,0 +1,418 @@
+#include "Corpus.hpp"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace hirzel::json
+{
+	// xorshift64* is used instead of <random> because the standard
+	// distributions are implementation-defined and would make the corpus
+	// differ between standard libraries.
+	class Random
+	{
+		uint64_t _state;
+
+	public:
+
+		Random(uint64_t seed):
+			_state(seed)
+		{}
+
+		uint64_t next()
+		{
+			_state ^= _state >> 12;
+			_state ^= _state << 25;
+			_state ^= _state >> 27;
+
+			return _state * 0x2545F4914F6CDD1DULL;
+		}
+
+		uint64_t below(uint64_t bound)
+		{
+			return next() % bound;
+		}
+
+		double decimal(double min, double max)
+		{
+			auto unit = (double)(next() >> 11) / (double)(1ULL << 53);
+
+			return min + unit * (max - min);
+		}
+
+		bool chance(unsigned percent)
+		{
+			return below(100) < percent;
+		}
+	};
+
+	static const char* const words[] = {
+		"alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel",
+		"india", "juliet", "kilo", "lima", "mike", "november", "oscar", "papa",
+		"quebec", "romeo", "sierra", "tango", "uniform", "victor", "whiskey",
+		"xray", "yankee", "zulu", "request", "response", "timeout", "session",
+		"cache", "miss", "hit", "upstream", "latency", "gateway", "shard"
+	};
+
+	static const size_t wordCount = sizeof(words) / sizeof(*words);
+
+	static void appendWords(std::string& out, Random& random, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (i > 0)
+				out += ' ';
+
+			out += words[random.below(wordCount)];
+		}
+	}
+
+	static void appendString(std::string& out, Random& random, size_t wordCount)
+	{
+		out += '\"';
+		appendWords(out, random, wordCount);
+		out += '\"';
+	}
+
+	static void appendInteger(std::string& out, long long value)
+	{
+		out += std::to_string(value);
+	}
+
+	static void appendDecimal(std::string& out, double value, int precision)
+	{
+		char buffer[64];
+
+		snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+
+		out += buffer;
+	}
+
+	static void appendBoolean(std::string& out, bool value)
+	{
+		out += value ? "true" : "false";
+	}
+
+	static std::string generateDeepNesting(Random& random)
+	{
+		const size_t treeCount = 64;
+		const size_t depth = 96;
+		auto out = std::string("[");
+
+		for (size_t tree = 0; tree < treeCount; ++tree)
+		{
+			if (tree > 0)
+				out += ',';
+
+			for (size_t level = 0; level < depth; ++level)
+			{
+				out += "{\"level\":";
+				appendInteger(out, level);
+				out += ",\"name\":";
+				appendString(out, random, 1);
+				out += ",\"child\":";
+			}
+
+			out += "null";
+
+			for (size_t level = 0; level < depth; ++level)
+				out += '}';
+		}
+
+		out += ']';
+
+		return out;
+	}
+
+	static std::string generateWideNumbers(Random& random)
+	{
+		const size_t count = 200000;
+		auto out = std::string("[");
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (i > 0)
+				out += ',';
+
+			if (random.chance(50))
+			{
+				appendInteger(out, (long long)random.below(1000000000) - 500000000);
+			}
+			else
+			{
+				appendDecimal(out, random.decimal(-1e6, 1e6), 6);
+			}
+		}
+
+		out += ']';
+
+		return out;
+	}
+
+	static std::string generateLogs(Random& random)
+	{
+		static const char* const levels[] = { "debug", "info", "warn", "error" };
+		const size_t count = 10000;
+		auto out = std::string("[");
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (i > 0)
+				out += ',';
+
+			out += "{\"timestamp\":\"2024-03-";
+			appendInteger(out, 10 + random.below(18));
+			out += "T12:";
+			appendInteger(out, 10 + random.below(50));
+			out += ":";
+			appendInteger(out, 10 + random.below(50));
+			out += "Z\",\"level\":\"";
+			out += levels[random.below(4)];
+			out += "\",\"service\":";
+			appendString(out, random, 1);
+			out += ",\"message\":";
+			appendString(out, random, 8 + random.below(24));
+			out += ",\"trace\":\"";
+
+			for (size_t j = 0; j < 32; ++j)
+				out += "0123456789abcdef"[random.below(16)];
+
+			out += "\"}";
+		}
+
+		out += ']';
+
+		return out;
+	}
+
+	static void appendUser(std::string& out, Random& random)
+	{
+		out += "{\"id\":";
+		appendInteger(out, (long long)random.below(4000000000ULL));
+		out += ",\"name\":";
+		appendString(out, random, 2);
+		out += ",\"screen_name\":";
+		appendString(out, random, 1);
+		out += ",\"location\":";
+		appendString(out, random, 2);
+		out += ",\"description\":";
+		appendString(out, random, 12);
+		out += ",\"followers_count\":";
+		appendInteger(out, random.below(100000));
+		out += ",\"friends_count\":";
+		appendInteger(out, random.below(5000));
+		out += ",\"verified\":";
+		appendBoolean(out, random.chance(5));
+		out += ",\"profile_image_url\":\"http://example.com/profile/";
+		appendInteger(out, random.below(1000000));
+		out += ".png\"}";
+	}
+
+	static std::string generateTwitter(Random& random)
+	{
+		const size_t count = 2000;
+		auto out = std::string("{\"statuses\":[");
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (i > 0)
+				out += ',';
+
+			out += "{\"created_at\":\"Sun Aug 31 00:29:15 +0000 2014\",\"id\":";
+			appendInteger(out, 505874924095815681LL + (long long)i);
+			out += ",\"text\":";
+			appendString(out, random, 6 + random.below(14));
+			out += ",\"truncated\":false,\"user\":";
+			appendUser(out, random);
+			out += ",\"entities\":{\"hashtags\":[";
+
+			auto hashtagCount = random.below(4);
+
+			for (size_t j = 0; j < hashtagCount; ++j)
+			{
+				if (j > 0)
+					out += ',';
+
+				out += "{\"text\":";
+				appendString(out, random, 1);
+				out += ",\"indices\":[";
+				appendInteger(out, random.below(70));
+				out += ',';
+				appendInteger(out, 70 + random.below(70));
+				out += "]}";
+			}
+
+			out += "],\"urls\":[]},\"retweet_count\":";
+			appendInteger(out, random.below(1000));
+			out += ",\"favorite_count\":";
+			appendInteger(out, random.below(1000));
+			out += ",\"favorited\":false,\"retweeted\":false,\"lang\":\"en\",\"geo\":null}";
+		}
+
+		out += "],\"search_metadata\":{\"completed_in\":0.087,\"count\":";
+		appendInteger(out, count);
+		out += "}}";
+
+		return out;
+	}
+
+	static std::string generateCitm(Random& random)
+	{
+		const size_t eventCount = 1000;
+		auto out = std::string("{\"events\":{");
+
+		for (size_t i = 0; i < eventCount; ++i)
+		{
+			if (i > 0)
+				out += ',';
+
+			auto id = 138586341 + i;
+
+			out += '\"';
+			appendInteger(out, id);
+			out += "\":{\"description\":null,\"id\":";
+			appendInteger(out, id);
+			out += ",\"logo\":null,\"name\":";
+			appendString(out, random, 3);
+			out += ",\"subTopicIds\":[";
+			appendInteger(out, 337184269 + random.below(100));
+			out += ',';
+			appendInteger(out, 337184283 + random.below(100));
+			out += "],\"subjectCode\":null,\"subtitle\":null,\"topicIds\":[";
+			appendInteger(out, 324846099 + random.below(100));
+			out += ',';
+			appendInteger(out, 107888604 + random.below(100));
+			out += "]}";
+		}
+
+		out += "},\"performances\":[";
+
+		for (size_t i = 0; i < eventCount; ++i)
+		{
+			if (i > 0)
+				out += ',';
+
+			out += "{\"eventId\":";
+			appendInteger(out, 138586341 + i);
+			out += ",\"id\":";
+			appendInteger(out, 339887544 + i);
+			out += ",\"logo\":null,\"name\":null,\"prices\":[";
+
+			auto priceCount = 1 + random.below(6);
+
+			for (size_t j = 0; j < priceCount; ++j)
+			{
+				if (j > 0)
+					out += ',';
+
+				out += "{\"amount\":";
+				appendInteger(out, 9000 + random.below(200000));
+				out += ",\"audienceSubCategoryId\":337100890,\"seatCategoryId\":";
+				appendInteger(out, 338937295 + random.below(100));
+				out += '}';
+			}
+
+			out += "],\"seatCategories\":[{\"areas\":[{\"areaId\":205705999,\"blockIds\":[]}],\"seatCategoryId\":338937295}],\"seatMapImage\":null,\"start\":";
+			appendInteger(out, 1372608000000LL + (long long)random.below(100000000));
+			out += ",\"venueCode\":\"PLEYEL_PLEYEL\"}";
+		}
+
+		out += "]}";
+
+		return out;
+	}
+
+	static std::string generateCanada(Random& random)
+	{
+		const size_t polygonCount = 48;
+		const size_t pointCount = 1200;
+		auto out = std::string("{\"type\":\"FeatureCollection\",\"features\":[{\"type\":\"Feature\",\"properties\":{\"name\":\"Canada\"},\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[");
+
+		for (size_t polygon = 0; polygon < polygonCount; ++polygon)
+		{
+			if (polygon > 0)
+				out += ',';
+
+			out += '[';
+
+			auto longitude = random.decimal(-140.0, -50.0);
+			auto latitude = random.decimal(42.0, 83.0);
+
+			for (size_t point = 0; point < pointCount; ++point)
+			{
+				if (point > 0)
+					out += ',';
+
+				longitude += random.decimal(-0.01, 0.01);
+				latitude += random.decimal(-0.01, 0.01);
+
+				out += '[';
+				appendDecimal(out, longitude, 15);
+				out += ',';
+				appendDecimal(out, latitude, 15);
+				out += ']';
+			}
+
+			out += ']';
+		}
+
+		out += "]}}]}";
+
+		return out;
+	}
+
+	// Pages and embedded JSON documents stored as strings, as in payloads
+	// that pass rendered HTML or other services' responses through, so most
+	// of the text is escaped.
+	static std::string generateEscapedHtml(Random& random)
+	{
+		const size_t count = 2000;
+		auto out = std::string("[");
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (i > 0)
+				out += ',';
+
+			out += "{\"id\":";
+			appendInteger(out, (long long)i);
+			out += ",\"title\":\"caf\\u00e9 ";
+			appendWords(out, random, 2);
+			out += " \\ud83d\\ude00\",\"html\":\"<div class=\\\"card\\\">\\n";
+
+			for (size_t j = 0, paragraphCount = 2 + random.below(6); j < paragraphCount; ++j)
+			{
+				out += "\\t<p class=\\\"text\\\">";
+				appendWords(out, random, 6 + random.below(12));
+				out += "<\\/p>\\n";
+			}
+
+			out += "<\\/div>\",\"payload\":\"{\\\"user\\\":\\\"";
+			appendWords(out, random, 1);
+			out += "\\\",\\\"tags\\\":[\\\"";
+			appendWords(out, random, 1);
+			out += "\\\",\\\"";
+			appendWords(out, random, 1);
+			out += "\\\"],\\\"path\\\":\\\"C:\\\\\\\\logs\\\"}\"}";
+		}
+
+		out += ']';
+
+		return out;
+	}
+
+	std::vector<CorpusDocument> generateCorpus()
+	{
+		auto random = Random(0x9E3779B97F4A7C15ULL);
+		auto corpus = std::vector<CorpusDocument>();
+
+		corpus.push_back({ "deep-nesting", generateDeepNesting(random) });
+		corpus.push_back({ "wide-numbers", generateWideNumbers(random) });
+		corpus.push_back({ "string-logs", generateLogs(random) });
+		corpus.push_back({ "twitter", generateTwitter(random) });
+		corpus.push_back({ "citm", generateCitm(random) });
+		corpus.push_back({ "canada", generateCanada(random) });
+		corpus.push_back({ "escaped-html", generateEscapedHtml(random) });
+
+		return corpus;
+	}
+}
@@ -0,0 +1,20 @@
+#ifndef HIRZEL_JSON_CORPUS_HPP
+#define HIRZEL_JSON_CORPUS_HPP
+
+#include <string>
+#include <vector>
+
+namespace hirzel::json
+{
+	struct CorpusDocument
+	{
+		const char* name;
+		std::string json;
+	};
+
+	// Documents are generated from a fixed seed so that every run of the
+	// benchmark measures byte-for-byte identical input.
+	std::vector<CorpusDocument> generateCorpus();
+}
+
+#endif
@@ -0,0 +1,327 @@
+#include "AllocationCounter.hpp"
+#include "Corpus.hpp"
+
+#include "hirzel/json/Deserialization.hpp"
+#include "hirzel/json/LazyDocument.hpp"
+#include "hirzel/json/Ndjson.hpp"
+#include "hirzel/json/Reader.hpp"
+#include "hirzel/json/Serialization.hpp"
+#include "hirzel/json/StructuralIndex.hpp"
+#include "hirzel/json/Token.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+using namespace hirzel::json;
+
+struct Stage
+{
+	const char* name;
+	std::function<void()> run;
+};
+
+struct StageResult
+{
+	double megabytesPerSecond;
+	double allocationsPerDocument;
+	double p50Milliseconds;
+	double p99Milliseconds;
+};
+
+static double percentile(std::vector<double> samples, double fraction)
+{
+	std::sort(samples.begin(), samples.end());
+
+	auto index = (size_t)(fraction * (double)(samples.size() - 1) + 0.5);
+
+	return samples[index];
+}
+
+static StageResult measure(size_t byteCount, size_t iterations, const std::function<void()>& stage)
+{
+	auto samples = std::vector<double>();
+	auto totalSeconds = 0.0;
+
+	samples.reserve(iterations);
+
+	// The first run warms the caches and the allocator and is not recorded.
+	stage();
+
+	auto allocationsBefore = allocationCount();
+
+	for (size_t i = 0; i < iterations; ++i)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		stage();
+
+		auto end = std::chrono::steady_clock::now();
+		auto seconds = std::chrono::duration<double>(end - start).count();
+
+		totalSeconds += seconds;
+		samples.push_back(seconds * 1000.0);
+	}
+
+	auto allocations = allocationCount() - allocationsBefore;
+	auto result = StageResult();
+
+	result.megabytesPerSecond = (double)(byteCount * iterations) / totalSeconds / 1e6;
+	result.allocationsPerDocument = (double)allocations / (double)iterations;
+	result.p50Milliseconds = percentile(samples, 0.50);
+	result.p99Milliseconds = percentile(samples, 0.99);
+
+	return result;
+}
+
+static void printResult(const char* document, const char* stage, size_t byteCount, const StageResult& result)
+{
+	printf("%-14s %-20s %10.2f %10.1f %14.0f %10.3f %10.3f\n",
+		document,
+		stage,
+		(double)byteCount / 1e6,
+		result.megabytesPerSecond,
+		result.allocationsPerDocument,
+		result.p50Milliseconds,
+		result.p99Milliseconds);
+}
+
+// One record per element of the document's top-level array.
+static std::string toNdjson(const Value& array)
+{
+	auto text = std::string();
+
+	for (const auto& item : array.array())
+	{
+		text += serialize(item);
+		text += '\n';
+	}
+
+	return text;
+}
+
+static size_t deserializeLines(const std::string& text)
+{
+	size_t count = 0;
+	size_t position = 0;
+
+	while (position < text.size())
+	{
+		auto end = text.find('\n', position);
+
+		if (end == std::string::npos)
+			end = text.size();
+
+		count += deserialize(std::string_view(text).substr(position, end - position)).has_value();
+		position = end + 1;
+	}
+
+	return count;
+}
+
+// Values and keys in the tree, for comparing against allocations per
+// document. Each container allocates its node and its storage, and each
+// key and long string its text, so a parse that does not copy subtrees
+// allocates on the order of one block per node.
+static size_t countNodes(const Value& value)
+{
+	size_t count = 1;
+
+	if (value.isArray())
+	{
+		for (const auto& item : value.array())
+			count += countNodes(item);
+	}
+	else if (value.isObject())
+	{
+		for (const auto& pair : value.object())
+			count += 1 + countNodes(pair.second);
+	}
+
+	return count;
+}
+
+// Stands in for a consumer that only reads a few fields of each payload.
+static size_t readFirstChildren(std::string_view json, size_t count)
+{
+	auto document = LazyDocument::open(json);
+	size_t length = 0;
+
+	if (!document)
+		return 0;
+
+	document->root().forEach([&](std::string_view, const LazyValue& value)
+	{
+		length += value.text().length();
+		return --count > 0;
+	});
+
+	return length;
+}
+
+static size_t tokenize(const char* json)
+{
+	auto token = Token::parse(json);
+	size_t count = 0;
+
+	while (token && token->type() != TokenType::EndOfFile)
+	{
+		count += 1;
+		token = token->parseNext();
+	}
+
+	return count;
+}
+
+int main(int argc, char** argv)
+{
+	size_t iterations = 20;
+
+	if (argc > 1)
+		iterations = std::max(1, atoi(argv[1]));
+
+	auto corpus = generateCorpus();
+	volatile size_t sink = 0;
+	auto handler = Handler();
+	static char spanBuffer[16384];
+
+	printf("scanner: %s\n", scannerTypeName(bestScannerType()));
+	printf("threads: %zu\n", ThreadPool::shared().threadCount());
+	printf("%-14s %-20s %10s %10s %14s %10s %10s\n", "document", "stage", "size (MB)", "MB/s", "allocs/doc", "p50 (ms)", "p99 (ms)");
+
+	for (const auto& document : corpus)
+	{
+		const auto* json = document.json.c_str();
+		auto byteCount = document.json.size();
+		auto value = deserialize(json);
+
+		if (!value)
+		{
+			fprintf(stderr, "failed to deserialize %s\n", document.name);
+			return 1;
+		}
+
+		printf("%-14s %-20s %10zu\n", document.name, "nodes", countNodes(*value));
+
+		auto borrowOptions = DeserializationOptions();
+
+		borrowOptions.borrowStrings = true;
+
+		// The pool is warm after the first run, as it would be in a service.
+		auto keyPool = KeyPool();
+		auto keyPoolOptions = DeserializationOptions();
+
+		keyPoolOptions.keyPool = &keyPool;
+
+		auto parallelOptions = ParallelDeserializationOptions();
+
+		parallelOptions.minParallelLength = 0;
+
+		auto parallelSerialization = SerializationOptions();
+
+		parallelSerialization.minParallelLength = 64;
+
+		// Stands in for a socket buffer that is sent whenever it fills up.
+		auto spanWriter = SpanWriter(spanBuffer, sizeof(spanBuffer), [&](const char*, size_t length)
+		{
+			sink = sink + length;
+			return true;
+		});
+
+		auto stages = std::vector<Stage>
+		{
+			{ "Token::parseNext", [&]()
+			{
+				sink = sink + tokenize(json);
+			}},
+			{ "readEvents", [&]()
+			{
+				sink = sink + read(json, handler);
+			}},
+			{ "deserializeValue", [&]()
+			{
+				sink = sink + deserialize(json).has_value();
+			}},
+			{ "keyPool", [&]()
+			{
+				sink = sink + deserialize(json, keyPoolOptions).has_value();
+			}},
+			{ "deserializeParallel", [&]()
+			{
+				sink = sink + deserializeParallel(document.json, parallelOptions).has_value();
+			}},
+			{ "lazyDocument", [&]()
+			{
+				sink = sink + readFirstChildren(document.json, 3);
+			}},
+			{ "deserializeDocument", [&]()
+			{
+				sink = sink + deserializeDocument(json).has_value();
+			}},
+			{ "borrowStrings", [&]()
+			{
+				sink = sink + deserializeDocument(json, borrowOptions).has_value();
+			}},
+			{ "copyValue", [&]()
+			{
+				auto copy = *value;
+
+				sink = sink + copy.length();
+			}},
+			{ "serializeObject", [&]()
+			{
+				sink = sink + serialize(*value).size();
+			}},
+			{ "serializeParallel", [&]()
+			{
+				sink = sink + serialize(*value, parallelSerialization).size();
+			}},
+			{ "serializeSpan", [&]()
+			{
+				sink = sink + serialize(*value, spanWriter);
+			}}
+		};
+
+		for (const auto& stage : stages)
+		{
+			auto result = measure(byteCount, iterations, stage.run);
+
+			printResult(document.name, stage.name, byteCount, result);
+		}
+	}
+
+	for (const auto& document : corpus)
+	{
+		if (std::string(document.name) != "string-logs")
+			continue;
+
+		auto ndjson = toNdjson(*deserialize(document.json));
+		auto stages = std::vector<Stage>
+		{
+			{ "deserializeLines", [&]()
+			{
+				sink = sink + deserializeLines(ndjson);
+			}},
+			{ "readNdjson", [&]()
+			{
+				readNdjson(ndjson, [&](size_t, std::optional<Value>&& value)
+				{
+					sink = sink + value.has_value();
+					return true;
+				});
+			}}
+		};
+
+		for (const auto& stage : stages)
+		{
+			auto result = measure(ndjson.size(), iterations, stage.run);
+
+			printResult("ndjson-logs", stage.name, ndjson.size(), result);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,31 @@
+#ifndef HIRZEL_JSON_ARENA_HPP
+#define HIRZEL_JSON_ARENA_HPP
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace hirzel::json
+{
+	// Monotonic allocator that owns every node, string buffer and container
+	// of a document. Individual deallocations are no-ops; all memory is
+	// released at once when the arena is destroyed.
+	class Arena
+	{
+		std::pmr::monotonic_buffer_resource _resource;
+
+	public:
+
+		Arena();
+		explicit Arena(size_t initialSize);
+		Arena(Arena&&) = delete;
+		Arena(const Arena&) = delete;
+		Arena& operator=(Arena&&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		std::pmr::memory_resource* resource() { return &_resource; }
+	};
+}
+
+#endif
@@ -1,15 +1,78 @@
 #ifndef HIRZEL_JSON_DESERIALIZATION_HPP
 #define HIRZEL_JSON_DESERIALIZATION_HPP
 
+#include "hirzel/json/Document.hpp"
+#include "hirzel/json/KeyPool.hpp"
+#include "hirzel/json/ParseError.hpp"
+#include "hirzel/json/ThreadPool.hpp"
 #include "hirzel/json/Token.hpp"
 #include "hirzel/json/Value.hpp"
 
 #include <optional>
+#include <string>
+#include <string_view>
 
 namespace hirzel::json
 {
-	std::optional<Value> deserialize(const char *json);
-	std::optional<Value> deserialize(const std::string& json);
+	struct DeserializationOptions
+	{
+		// Strings and keys without escape sequences reference the input
+		// instead of being copied out of it. The input must then outlive the
+		// deserialized value.
+		bool borrowStrings = false;
+		// Object keys are interned so that objects with the same keys share
+		// one copy of each. Documents intern them in a pool of their own.
+		bool internKeys = false;
+		// Pool to intern keys in for any kind of parse, which may be shared
+		// between parses and threads. It must outlive the deserialized
+		// values. Takes precedence over a document's own pool.
+		KeyPool* keyPool = nullptr;
+		// Texts with arrays and objects nested deeper than this are rejected,
+		// which bounds the memory a hostile text can make the parser use.
+		// 0 removes the limit.
+		size_t maxDepth = 1024;
+		// Receives the error of a failed parse, which then is not passed to
+		// the callback set with onError. Nothing is formatted or allocated
+		// unless its message is asked for, and each thread can pass its own.
+		// It refers to the text, except that deserializeFile detaches parse
+		// errors from the file and refers to the path for I/O errors.
+		ParseError* error = nullptr;
+	};
+
+	struct ParallelDeserializationOptions
+	{
+		DeserializationOptions deserialization;
+		// Pool the elements are parsed on. ThreadPool::shared() is used if
+		// none is given.
+		ThreadPool* pool = nullptr;
+		// Texts shorter than this are parsed on the calling thread.
+		size_t minParallelLength = 1024 * 1024;
+	};
+
+	// The text is read up to its length and does not need to be terminated,
+	// so slices of larger buffers can be deserialized in place. The overloads
+	// taking only a const char* read up to the terminator.
+	std::optional<Value> deserialize(const char* json, size_t length, const DeserializationOptions& options = {});
+	std::optional<Value> deserialize(std::string_view json, const DeserializationOptions& options = {});
+	std::optional<Value> deserialize(const char *json, const DeserializationOptions& options = {});
+	std::optional<Value> deserialize(const std::string& json, const DeserializationOptions& options = {});
+	std::optional<Document> deserializeDocument(const char* json, size_t length, const DeserializationOptions& options = {});
+	std::optional<Document> deserializeDocument(std::string_view json, const DeserializationOptions& options = {});
+	std::optional<Document> deserializeDocument(const char* json, const DeserializationOptions& options = {});
+	std::optional<Document> deserializeDocument(const std::string& json, const DeserializationOptions& options = {});
+
+	// Parses a text whose root is an array by finding the boundaries of its
+	// elements in a structural pre-pass and parsing ranges of elements on a
+	// thread pool. Texts with other roots, or that cannot be indexed, are
+	// parsed on the calling thread.
+	std::optional<Value> deserializeParallel(const char* json, size_t length, const ParallelDeserializationOptions& options = {});
+	std::optional<Value> deserializeParallel(std::string_view json, const ParallelDeserializationOptions& options = {});
+
+	// Parses a file directly out of a read-only memory mapping of it. When
+	// strings are borrowed, the document keeps the mapping alive; otherwise
+	// it is unmapped once parsing is done.
+	std::optional<Document> deserializeFile(const char* path, const DeserializationOptions& options = {});
+	std::optional<Document> deserializeFile(const std::string& path, const DeserializationOptions& options = {});
 }
 
 #endif
@@ -0,0 +1,61 @@
+#ifndef HIRZEL_JSON_DOCUMENT_HPP
+#define HIRZEL_JSON_DOCUMENT_HPP
+
+#include "hirzel/json/Arena.hpp"
+#include "hirzel/json/KeyPool.hpp"
+#include "hirzel/json/MappedFile.hpp"
+#include "hirzel/json/Value.hpp"
+
+#include <memory>
+#include <optional>
+
+namespace hirzel::json
+{
+	struct DeserializationOptions;
+
+	// Value tree whose nodes, strings and containers are all placed in an
+	// Arena owned by the document. Copies of values taken from the document
+	// are heap allocated and independent of it, but values moved out of it
+	// must not outlive the document. A document may also own the file its
+	// strings were borrowed from and the pool its keys were interned in.
+	class Document
+	{
+		// Declared before the root so that the root is destroyed first.
+		std::optional<MappedFile> _source;
+		std::unique_ptr<KeyPool> _keyPool;
+		std::unique_ptr<Arena> _arena;
+		Value _root;
+
+		// Marks the root as parsed entirely into the arena. Until the root is
+		// accessed mutably, the tree is released with the arena without
+		// visiting its nodes.
+		void sealRoot() { _root.seal(); }
+		void releaseRoot();
+
+		friend std::optional<Document> deserializeDocument(const char* json, size_t length, const DeserializationOptions& options);
+
+	public:
+
+		Document();
+		explicit Document(size_t arenaSize);
+		Document(Document&& other) noexcept;
+		Document(const Document&) = delete;
+		~Document();
+
+		Document& operator=(Document&& other) noexcept;
+		Document& operator=(const Document&) = delete;
+
+		// Keeps the file alive for as long as the document.
+		void setSource(MappedFile&& source) { _source = std::move(source); }
+		const MappedFile* source() const { return _source ? &*_source : nullptr; }
+
+		// Pool of the document's interned keys, created on first use.
+		KeyPool& keyPool();
+
+		Arena& arena() { return *_arena; }
+		Value& root() { return _root; }
+		const Value& root() const { return _root; }
+	};
+}
+
+#endif
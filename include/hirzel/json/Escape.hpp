@@ -0,0 +1,23 @@
+#ifndef HIRZEL_JSON_ESCAPE_HPP
+#define HIRZEL_JSON_ESCAPE_HPP
+
+#include <optional>
+#include <string_view>
+
+namespace hirzel::json
+{
+	// Decodes the escape sequences in the text between a string's quotes
+	// into out, which must have room for text.length() characters as
+	// decoding never lengthens a text. \uXXXX sequences, including
+	// surrogate pairs, are written as UTF-8. Returns the decoded length, or
+	// nothing if an escape sequence is invalid, in which case errorOffset is
+	// where it starts.
+	std::optional<size_t> unescape(std::string_view text, char* out, size_t& errorOffset);
+
+	// Position of the first quote, backslash or control character at or
+	// after index, which are the characters a JSON string must escape, or
+	// text.length() if there is none.
+	size_t findEscapable(std::string_view text, size_t index);
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef HIRZEL_JSON_EVENT_HPP
+#define HIRZEL_JSON_EVENT_HPP
+
+#include "hirzel/json/EventType.hpp"
+#include "hirzel/json/Value.hpp"
+
+#include <string_view>
+
+namespace hirzel::json
+{
+	// A single step through a JSON text. Keys and strings carry their text
+	// without quotes and with escape sequences decoded. It refers to the
+	// input, which must outlive the event, or for text with escape sequences
+	// to the reader, which reuses it for the next event. Numbers and
+	// booleans also carry their value.
+	class Event
+	{
+		EventType _type;
+		std::string_view _text;
+		Value _value;
+
+	public:
+
+		Event(EventType type, std::string_view text = {}, Value&& value = Value()):
+			_type(type),
+			_text(text),
+			_value(std::move(value))
+		{}
+
+		const auto& type() const { return _type; }
+		const auto& text() const { return _text; }
+		const auto& value() const { return _value; }
+
+		double number() const { return _value.number(); }
+		int64_t integer() const { return _value.integer(); }
+		bool isInteger() const { return _value.isInteger(); }
+		bool boolean() const { return _value.boolean(); }
+	};
+}
+
+#endif
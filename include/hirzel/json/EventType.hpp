@@ -0,0 +1,26 @@
+#ifndef HIRZEL_JSON_EVENT_TYPE_HPP
+#define HIRZEL_JSON_EVENT_TYPE_HPP
+
+#include <ostream>
+
+namespace hirzel::json
+{
+	enum class EventType: unsigned char
+	{
+		StartObject,
+		EndObject,
+		StartArray,
+		EndArray,
+		Key,
+		String,
+		Number,
+		Boolean,
+		Null,
+		EndOfFile
+	};
+
+	const char* eventTypeName(EventType eventType);
+	std::ostream& operator<<(std::ostream& out, EventType eventType);
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef HIRZEL_JSON_HANDLER_HPP
+#define HIRZEL_JSON_HANDLER_HPP
+
+#include "hirzel/json/Value.hpp"
+
+#include <string_view>
+
+namespace hirzel::json
+{
+	// Receives the events of a JSON text as it is read. Each function
+	// returns false to stop reading. Text passed to key() and string() has
+	// its escape sequences decoded and is only valid during the call.
+	class Handler
+	{
+	public:
+
+		virtual ~Handler() = default;
+
+		virtual bool startObject() { return true; }
+		virtual bool endObject() { return true; }
+		virtual bool startArray() { return true; }
+		virtual bool endArray() { return true; }
+		virtual bool key(std::string_view) { return true; }
+		virtual bool string(std::string_view) { return true; }
+		virtual bool number(const Value&) { return true; }
+		virtual bool boolean(bool) { return true; }
+		virtual bool null() { return true; }
+	};
+}
+
+#endif
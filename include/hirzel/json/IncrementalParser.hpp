@@ -0,0 +1,127 @@
+#ifndef HIRZEL_JSON_INCREMENTAL_PARSER_HPP
+#define HIRZEL_JSON_INCREMENTAL_PARSER_HPP
+
+#include "hirzel/json/ParseError.hpp"
+#include "hirzel/json/Value.hpp"
+
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hirzel::json
+{
+	struct IncrementalParserOptions
+	{
+		// Values with arrays and objects nested deeper than this are
+		// rejected. 0 removes the limit.
+		size_t maxDepth = 1024;
+		// Longest string, number or literal that is buffered while it
+		// arrives, which bounds the memory a hostile stream can make the
+		// parser use besides the values it builds. 0 removes the limit.
+		size_t maxTokenLength = 64 * 1024 * 1024;
+		// Receives the error once the stream is found to be invalid, which
+		// then is not passed to the callback set with onError. It is located
+		// by its line and column in the stream, as the input is not kept.
+		ParseError* error = nullptr;
+	};
+
+	// Parses a stream of whitespace-separated JSON values that arrives in
+	// chunks of any size, such as reads from a socket or pipe. Chunks may
+	// end anywhere, including inside strings, numbers and comments. Values
+	// are built as their characters arrive, so only the string, number or
+	// literal being received is buffered, and the state of the containers
+	// being parsed is kept between chunks.
+	class IncrementalParser
+	{
+		enum class State: unsigned char
+		{
+			Normal,
+			Scalar,
+			String,
+			StringEscape,
+			Slash,
+			LineComment,
+			BlockComment,
+			BlockCommentStar
+		};
+
+		// What the next token must be.
+		enum class Expect: unsigned char
+		{
+			Value,
+			ValueOrEnd,
+			Key,
+			KeyOrEnd,
+			Colon,
+			CommaOrEnd
+		};
+
+		// Container that is being parsed.
+		struct Frame
+		{
+			bool isObject;
+			// Size of the scratch stack of the container's children when the
+			// container started.
+			size_t start;
+		};
+
+		IncrementalParserOptions _options;
+		// Text of the token being received. Strings are kept without their
+		// quotes and with their escape sequences.
+		std::string _token;
+		// Strings are decoded here before they are copied into their value.
+		std::string _scratch;
+		// Children of the containers being parsed, innermost last.
+		std::vector<Value> _children;
+		std::vector<Object::value_type> _members;
+		std::vector<Frame> _frames;
+		std::deque<Value> _values;
+		// Location of the character being consumed.
+		size_t _offset;
+		size_t _line;
+		size_t _column;
+		// Location of the first character of the token being received.
+		size_t _tokenOffset;
+		size_t _tokenLine;
+		size_t _tokenColumn;
+		State _state;
+		Expect _expect;
+		bool _isFailed;
+
+		bool consume(char c);
+		bool consumeNormal(char c);
+		bool startToken(char c, State state);
+		bool appendToken(char c);
+		bool completeString();
+		bool completeScalar();
+		bool completeValue(Value&& value);
+		bool endContainer(char c);
+		const char* expected() const;
+		bool fail(ErrorCode code, size_t offset, size_t line, size_t column, const char* detail);
+		bool failInToken(ErrorCode code, size_t index, const char* detail);
+
+	public:
+
+		explicit IncrementalParser(const IncrementalParserOptions& options = {});
+
+		// Consumes the next chunk of input. Returns false if the input is
+		// invalid, after which the parser rejects further input.
+		bool feed(const char* data, size_t length);
+		bool feed(std::string_view chunk) { return feed(chunk.data(), chunk.length()); }
+
+		// Marks the end of the input, which completes a trailing number or
+		// literal. Returns false if the input ended inside a value.
+		bool finish();
+
+		// Takes the oldest completed value, if any.
+		std::optional<Value> next();
+
+		size_t pendingCount() const { return _values.size(); }
+		size_t depth() const { return _frames.size(); }
+		bool isFailed() const { return _isFailed; }
+	};
+}
+
+#endif
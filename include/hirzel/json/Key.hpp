@@ -0,0 +1,61 @@
+#ifndef HIRZEL_JSON_KEY_HPP
+#define HIRZEL_JSON_KEY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace hirzel::json
+{
+	// FNV-1a, which can be evaluated at compile time. Object indexes use it
+	// so that the hash of a Key can be used to search them.
+	constexpr size_t hashKey(std::string_view key)
+	{
+		uint64_t hash = 14695981039346656037ULL;
+
+		for (auto c : key)
+		{
+			hash ^= (unsigned char)c;
+			hash *= 1099511628211ULL;
+		}
+
+		return (size_t)hash;
+	}
+
+	// Object key whose hash is computed once, at compile time for constants,
+	// instead of on every lookup. The text is referenced, not copied.
+	class Key
+	{
+		std::string_view _text;
+		size_t _hash;
+
+		// Pointers keep the hashes of their keys rather than the Keys, as
+		// their text moves when a Pointer is copied.
+		constexpr Key(std::string_view text, size_t hash):
+			_text(text),
+			_hash(hash)
+		{}
+
+		friend class Pointer;
+
+	public:
+
+		explicit constexpr Key(std::string_view text):
+			_text(text),
+			_hash(hashKey(text))
+		{}
+
+		constexpr std::string_view text() const { return _text; }
+		constexpr size_t hash() const { return _hash; }
+	};
+
+	namespace literals
+	{
+		constexpr Key operator""_key(const char* text, size_t length)
+		{
+			return Key(std::string_view(text, length));
+		}
+	}
+}
+
+#endif
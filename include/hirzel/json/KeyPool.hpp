@@ -0,0 +1,37 @@
+#ifndef HIRZEL_JSON_KEY_POOL_HPP
+#define HIRZEL_JSON_KEY_POOL_HPP
+
+#include "hirzel/json/Arena.hpp"
+#include "hirzel/json/String.hpp"
+
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_set>
+
+namespace hirzel::json
+{
+	// Table of object keys that are stored once and shared by every object
+	// that uses them. Interned keys are borrowed Strings pointing into the
+	// pool, so the pool must outlive the values they are used in, and equal
+	// interned keys have the same data pointer. A pool may be shared by
+	// parses on several threads.
+	class KeyPool
+	{
+		mutable std::shared_mutex _mutex;
+		Arena _arena;
+		std::unordered_set<std::string_view> _keys;
+
+	public:
+
+		KeyPool();
+		KeyPool(KeyPool&&) = delete;
+		KeyPool(const KeyPool&) = delete;
+		KeyPool& operator=(KeyPool&&) = delete;
+		KeyPool& operator=(const KeyPool&) = delete;
+
+		String intern(std::string_view key);
+		size_t size() const;
+	};
+}
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef HIRZEL_JSON_LAZY_DOCUMENT_HPP
+#define HIRZEL_JSON_LAZY_DOCUMENT_HPP
+
+#include "hirzel/json/ParseError.hpp"
+#include "hirzel/json/StructuralIndex.hpp"
+#include "hirzel/json/Value.hpp"
+
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace hirzel::json
+{
+	class LazyDocument;
+
+	// Position of a value in a LazyDocument. Nothing is parsed until the
+	// value is read: looking up a member or element steps over the others
+	// using the document's bracket table, without tokenizing their
+	// contents.
+	class LazyValue
+	{
+		const LazyDocument* _document;
+		// Entry of the value's first character in the structural index.
+		size_t _entry;
+
+		LazyValue(const LazyDocument& document, size_t entry);
+
+		char firstChar() const;
+
+		friend class LazyDocument;
+
+	public:
+
+		ValueType type() const;
+		bool isNull() const { return type() == ValueType::Null; }
+		bool isNumber() const { return type() == ValueType::Number; }
+		bool isBoolean() const { return type() == ValueType::Boolean; }
+		bool isString() const { return type() == ValueType::String; }
+		bool isArray() const { return type() == ValueType::Array; }
+		bool isObject() const { return type() == ValueType::Object; }
+
+		// Text of the value in the source, including quotes and brackets.
+		std::string_view text() const;
+		// Text between a string's quotes, with escape sequences kept as they
+		// are. value() decodes them.
+		std::string_view string() const;
+
+		// Number of elements or members, found without parsing them.
+		size_t length() const;
+
+		std::optional<LazyValue> at(size_t i) const;
+		// Keys are compared after decoding their escape sequences.
+		std::optional<LazyValue> at(std::string_view key) const;
+
+		// Visits each member of an object or each element of an array, with
+		// an empty key, until the callback returns false. Keys are passed as
+		// they are written, like string(). Returns false if a member or
+		// element is not followed by the expected punctuation, which opening
+		// does not check.
+		bool forEach(const std::function<bool(std::string_view key, const LazyValue& value)>& callback, ParseError* error = nullptr) const;
+
+		// Parses the value and everything in it.
+		std::optional<Value> value() const;
+	};
+
+	// JSON text opened for on-demand access. Opening builds the structural
+	// index of the text and pairs up its brackets, which is all that is
+	// needed to step over values. Only the brackets are checked when
+	// opening, so errors inside values are reported when they are read. The
+	// text is not copied and must outlive the document.
+	class LazyDocument
+	{
+		const char* _src;
+		size_t _length;
+		StructuralIndex _index;
+		// For each entry of an opening bracket, the entry of its closing
+		// bracket. Other entries are unused.
+		std::vector<uint32_t> _closers;
+
+		LazyDocument(const char* src, size_t length, StructuralIndex&& index);
+
+		// First character of an entry, or '\0' past the last one.
+		char charAt(size_t entry) const;
+		// Entry following the value that starts at the given entry.
+		size_t skip(size_t entry) const;
+		bool structureError(size_t entry, const char* expected, ParseError* error) const;
+
+		friend class LazyValue;
+
+	public:
+
+		// Errors are recorded in error if one is given, and otherwise passed
+		// to the callback set with onError.
+		static std::optional<LazyDocument> open(const char* src, size_t length, ParseError* error = nullptr);
+		static std::optional<LazyDocument> open(std::string_view src, ParseError* error = nullptr);
+
+		// Values refer to the document, so they must not outlive it and
+		// are invalidated when it is moved.
+		LazyValue root() const;
+	};
+}
+
+#endif
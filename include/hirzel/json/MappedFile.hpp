@@ -0,0 +1,40 @@
+#ifndef HIRZEL_JSON_MAPPED_FILE_HPP
+#define HIRZEL_JSON_MAPPED_FILE_HPP
+
+#include "hirzel/json/ParseError.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace hirzel::json
+{
+	// Read-only memory mapping of a whole file, unmapped on destruction. The
+	// mapping is advised for sequential access so that the kernel reads
+	// ahead while it is parsed.
+	class MappedFile
+	{
+		const char* _data;
+		size_t _length;
+
+		MappedFile(const char* data, size_t length);
+
+	public:
+
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile(const MappedFile&) = delete;
+		~MappedFile();
+
+		MappedFile& operator=(MappedFile&& other) noexcept;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Errors refer to the path, which must outlive them.
+		static std::optional<MappedFile> open(const char* path, ParseError* error = nullptr);
+
+		const char* data() const { return _data; }
+		size_t length() const { return _length; }
+		std::string_view view() const { return { _data, _length }; }
+	};
+}
+
+#endif
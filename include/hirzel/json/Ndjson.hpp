@@ -0,0 +1,49 @@
+#ifndef HIRZEL_JSON_NDJSON_HPP
+#define HIRZEL_JSON_NDJSON_HPP
+
+#include "hirzel/json/Deserialization.hpp"
+#include "hirzel/json/ThreadPool.hpp"
+#include "hirzel/json/Value.hpp"
+
+#include <functional>
+#include <optional>
+#include <string_view>
+
+namespace hirzel::json
+{
+	// Receives the error of the record on the given zero-based line.
+	using NdjsonErrorCallback = std::function<void(size_t index, const ParseError& error)>;
+
+	struct NdjsonOptions
+	{
+		// Its error, if given, receives the error of the invalid record with
+		// the lowest index among those delivered. Offsets are relative to
+		// the start of that record's line.
+		DeserializationOptions deserialization;
+		// Called on the calling thread with the error of each invalid record,
+		// just before the record is delivered.
+		NdjsonErrorCallback errorCallback;
+		// Pool the records are parsed on. ThreadPool::shared() is used if
+		// none is given.
+		ThreadPool* pool = nullptr;
+		// Records are delivered in the order of the text. Otherwise they are
+		// delivered as soon as they are parsed, identified by their index.
+		bool isOrdered = true;
+		// Approximate number of bytes parsed by one task. 0 picks a size
+		// from the length of the text and the number of threads.
+		size_t batchSize = 0;
+	};
+
+	// Receives the record on the given zero-based line, or nothing if that
+	// line is not valid JSON. Returns false to stop reading.
+	using NdjsonCallback = std::function<bool(size_t index, std::optional<Value>&& value)>;
+
+	// Reads newline-delimited JSON (JSON Lines), parsing batches of records
+	// in parallel. Blank lines are skipped. The callbacks, including the one
+	// set with onError when no error is asked for, are always called on the
+	// calling thread. Returns false if the callback stopped reading.
+	bool readNdjson(const char* text, size_t length, const NdjsonCallback& callback, const NdjsonOptions& options = {});
+	bool readNdjson(std::string_view text, const NdjsonCallback& callback, const NdjsonOptions& options = {});
+}
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef HIRZEL_JSON_NUMBER_HPP
+#define HIRZEL_JSON_NUMBER_HPP
+
+#include "hirzel/json/Value.hpp"
+
+#include <optional>
+#include <string_view>
+
+namespace hirzel::json
+{
+	// Converts the text of a JSON number without allocating. Integers that
+	// fit in an int64_t are kept exact; everything else is parsed as the
+	// nearest double. Returns nothing if the text is not a number or is out
+	// of the range of a double.
+	std::optional<Value> parseNumber(std::string_view text);
+
+	// Enough space for any text written by formatNumber.
+	static constexpr size_t maxNumberLength = 32;
+
+	// Writes the shortest text that parses back to the same number into a
+	// buffer of at least maxNumberLength characters and returns the end of
+	// the text. Infinity and NaN have no JSON representation and are written
+	// as null.
+	char* formatNumber(char* out, const Value& value);
+}
+
+#endif
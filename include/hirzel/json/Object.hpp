@@ -0,0 +1,90 @@
+#ifndef HIRZEL_JSON_OBJECT_HPP
+#define HIRZEL_JSON_OBJECT_HPP
+
+#include "hirzel/json/Key.hpp"
+#include "hirzel/json/String.hpp"
+
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace hirzel::json
+{
+	class Value;
+
+	// Members of a JSON object, stored contiguously in insertion order. Small
+	// objects are searched linearly, which beats hashing at that size, and
+	// objects with at least indexThreshold members also keep an open
+	// addressing index of their keys. Like the standard containers it
+	// carries a polymorphic allocator so that a document can place it in
+	// its Arena. Keys must not be changed through iterators, as that would
+	// invalidate the index.
+	class Object
+	{
+	public:
+
+		using value_type = std::pair<String, Value>;
+		using allocator_type = std::pmr::polymorphic_allocator<value_type>;
+		using iterator = std::pmr::vector<value_type>::iterator;
+		using const_iterator = std::pmr::vector<value_type>::const_iterator;
+
+		static constexpr size_t indexThreshold = 16;
+
+	private:
+
+		std::pmr::vector<value_type> _members;
+		// Slots hold a member's position plus one, and 0 when empty.
+		std::pmr::vector<uint32_t> _index;
+
+		size_t findPosition(std::string_view key) const;
+		size_t findPosition(const Key& key) const;
+		size_t findLinear(std::string_view key) const;
+		size_t findIndexed(std::string_view key, size_t hash) const;
+		void addToIndex(size_t position);
+		void buildIndex();
+
+	public:
+
+		Object();
+		explicit Object(std::pmr::memory_resource* resource);
+		Object(Object&& other) noexcept;
+		Object(const Object& other);
+		Object(const Object& other, std::pmr::memory_resource* resource);
+		~Object();
+
+		Object& operator=(Object&& other);
+		Object& operator=(const Object& other);
+
+		allocator_type get_allocator() const { return _members.get_allocator(); }
+
+		iterator begin() { return _members.begin(); }
+		iterator end() { return _members.end(); }
+		const_iterator begin() const { return _members.begin(); }
+		const_iterator end() const { return _members.end(); }
+
+		size_t size() const { return _members.size(); }
+		bool empty() const { return _members.empty(); }
+		void reserve(size_t capacity);
+		void clear();
+
+		iterator find(std::string_view key);
+		const_iterator find(std::string_view key) const;
+		iterator find(const Key& key);
+		const_iterator find(const Key& key) const;
+		bool contains(std::string_view key) const { return findPosition(key) != _members.size(); }
+		bool contains(const Key& key) const { return findPosition(key) != _members.size(); }
+
+		// As with std::unordered_map, nothing is inserted if the key is
+		// already present.
+		std::pair<iterator, bool> emplace(String&& key, Value&& value);
+
+		// Inserts a null value if the key is not present.
+		Value& operator[](std::string_view key);
+
+		size_t erase(std::string_view key);
+	};
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef HIRZEL_JSON_PARSE_ERROR_HPP
+#define HIRZEL_JSON_PARSE_ERROR_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace hirzel::json
+{
+	enum class ErrorCode: unsigned char
+	{
+		None,
+		InvalidCharacter,
+		InvalidString,
+		UnterminatedString,
+		InvalidNumber,
+		InvalidKeyword,
+		UnexpectedToken,
+		NumberOutOfRange,
+		DepthExceeded,
+		UnbalancedBrackets,
+		UnexpectedEnd,
+		Unindexable,
+		InvalidPointer,
+		FileError,
+		LengthExceeded
+	};
+
+	const char* errorCodeName(ErrorCode code);
+
+	// Why and where a parse failed. It only refers to the text and to static
+	// descriptions, so recording it does not allocate, and the line, column
+	// and message are worked out when they are asked for. The text must
+	// still exist by then unless detachSource() was called.
+	class ParseError
+	{
+		const char* _src = nullptr;
+		size_t _srcLength = 0;
+		size_t _offset = 0;
+		// Length of the text the error is about, such as a token that was
+		// not expected.
+		size_t _length = 0;
+		size_t _line = 0;
+		size_t _column = 0;
+		// What was expected for UnexpectedToken, and otherwise what is wrong.
+		const char* _detail = nullptr;
+		ErrorCode _code = ErrorCode::None;
+
+	public:
+
+		ParseError() = default;
+		ParseError(ErrorCode code, const char* src, size_t srcLength, size_t offset, size_t length, const char* detail);
+		// For input that is not kept, such as a stream, whose position is
+		// tracked by the caller.
+		ParseError(ErrorCode code, size_t offset, size_t line, size_t column, const char* detail);
+
+		// Works out the location now and stops referring to the text, for
+		// when the text is freed before the error is read.
+		void detachSource();
+
+		// Both are 1-based and count bytes.
+		size_t line() const;
+		size_t column() const;
+		std::string_view text() const;
+		std::string message() const;
+
+		const auto& code() const { return _code; }
+		const auto& offset() const { return _offset; }
+		const auto* detail() const { return _detail; }
+
+		explicit operator bool() const { return _code != ErrorCode::None; }
+	};
+
+	// Records the error in result if the caller gave one. Otherwise its
+	// message is passed to the callback set with onError, if any.
+	void reportError(ParseError* result, const ParseError& error);
+}
+
+#endif
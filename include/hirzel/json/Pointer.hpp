@@ -0,0 +1,61 @@
+#ifndef HIRZEL_JSON_POINTER_HPP
+#define HIRZEL_JSON_POINTER_HPP
+
+#include "hirzel/json/ParseError.hpp"
+#include "hirzel/json/Value.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hirzel::json
+{
+	// RFC 6901 JSON Pointer, parsed once so that it can be resolved against
+	// many values. Reference tokens are unescaped and their hashes and
+	// array indices computed up front, so resolving neither allocates nor
+	// parses.
+	class Pointer
+	{
+		struct Segment
+		{
+			size_t offset;
+			size_t length;
+			size_t hash;
+			// Array index the token denotes, or noIndex for tokens that are
+			// not array indices, including "-".
+			size_t index;
+		};
+
+		static constexpr size_t noIndex = SIZE_MAX;
+
+		std::string _names;
+		std::vector<Segment> _segments;
+
+		template <typename V>
+		V* resolveValue(V& root) const;
+
+	public:
+
+		// The empty pointer refers to the root. Otherwise every reference
+		// token must be preceded by '/', and '~' may only appear as "~0"
+		// or "~1". Errors are recorded in error if one is given, and
+		// otherwise passed to the callback set with onError.
+		static std::optional<Pointer> parse(std::string_view text, ParseError* error = nullptr);
+
+		size_t size() const { return _segments.size(); }
+		std::string_view token(size_t i) const;
+
+		// Returns nothing if any reference token does not exist.
+		const Value* resolve(const Value& root) const;
+		Value* resolve(Value& root) const;
+	};
+
+	// Parses the pointer and resolves it. Paths used repeatedly should be
+	// parsed once into a Pointer instead.
+	const Value* resolve(const Value& root, std::string_view pointer);
+	Value* resolve(Value& root, std::string_view pointer);
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef HIRZEL_JSON_READER_HPP
+#define HIRZEL_JSON_READER_HPP
+
+#include "hirzel/json/Event.hpp"
+#include "hirzel/json/Handler.hpp"
+#include "hirzel/json/Token.hpp"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hirzel::json
+{
+	// Pulls the events of a JSON text one at a time without building a
+	// Value tree, so memory use depends on nesting depth rather than on the
+	// size of the text.
+	class Reader
+	{
+		enum class State: unsigned char
+		{
+			Value,
+			ObjectStart,
+			ArrayStart,
+			Key,
+			AfterValue,
+			Done,
+			Failed
+		};
+
+		std::optional<Token> _token;
+		std::vector<bool> _isObjectStack;
+		// Strings with escape sequences are decoded here.
+		std::string _scratch;
+		ParseError* _error;
+		State _state;
+
+		bool advance();
+		std::optional<std::string_view> decode(const Token& token);
+		std::optional<Event> fail(const char* expected);
+		std::optional<Event> readValue();
+		std::optional<Event> readKey();
+		std::optional<Event> readAfterValue();
+
+	public:
+
+		// Errors are recorded in error if one is given, and otherwise passed
+		// to the callback set with onError.
+		explicit Reader(const char* json, ParseError* error = nullptr);
+		Reader(const char* json, size_t length, ParseError* error = nullptr);
+
+		// Returns the next event, EndOfFile once the text has been read, or
+		// nothing if the text is invalid.
+		std::optional<Event> next();
+
+		size_t depth() const { return _isObjectStack.size(); }
+	};
+
+	// Reads the whole text, passing each event to the handler. Returns false
+	// if the text is invalid or the handler stopped reading.
+	bool read(const char* json, Handler& handler, ParseError* error = nullptr);
+	bool read(const char* json, size_t length, Handler& handler, ParseError* error = nullptr);
+}
+
+#endif
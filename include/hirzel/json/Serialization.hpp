@@ -1,11 +1,31 @@
 #ifndef HIRZEL_JSON_SERIALIZATION_HPP
 #define HIRZEL_JSON_SERIALIZATION_HPP
 
+#include "hirzel/json/ThreadPool.hpp"
 #include "hirzel/json/Value.hpp"
+#include "hirzel/json/Writer.hpp"
 
 namespace hirzel::json
 {
+	struct SerializationOptions
+	{
+		// Arrays and objects with at least this many children are
+		// serialized by splitting their children across a thread pool into
+		// separate buffers that are then written in order. 0 keeps
+		// serialization on the calling thread.
+		size_t minParallelLength = 0;
+		// Pool used for parallel serialization. ThreadPool::shared() is used
+		// if none is given.
+		ThreadPool* pool = nullptr;
+	};
+
 	std::string serialize(const Value& value);
+	std::string serialize(const Value& value, const SerializationOptions& options);
+
+	// Writes the value to the writer and flushes it. Returns false if the
+	// writer's sink failed.
+	bool serialize(const Value& value, Writer& writer);
+	bool serialize(const Value& value, Writer& writer, const SerializationOptions& options);
 }
 
 #endif
@@ -0,0 +1,105 @@
+#ifndef HIRZEL_JSON_STRING_HPP
+#define HIRZEL_JSON_STRING_HPP
+
+#include "hirzel/json/Arena.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace hirzel::json
+{
+	// Immutable string storage for values and object keys. The characters
+	// are either owned (heap allocated and freed with the string) or
+	// borrowed from an Arena or a caller-kept buffer, in which case they must
+	// outlive the string. Copies are always owned so that they may outlive
+	// the memory they were copied from.
+	class String
+	{
+		const char* _data;
+		uint32_t _length;
+		bool _isOwned;
+
+	public:
+
+		String();
+		String(std::string_view text);
+		String(const std::string& text);
+		String(const char* text);
+		String(std::string_view text, Arena& arena);
+		String(String&& other) noexcept;
+		String(const String& other);
+		~String();
+
+		String& operator=(String&& other) noexcept;
+		String& operator=(const String& other);
+
+		const char* data() const { return _data; }
+		size_t length() const { return _length; }
+		bool isEmpty() const { return _length == 0; }
+		bool isOwned() const { return _isOwned; }
+		std::string_view view() const { return { _data, _length }; }
+
+		operator std::string_view() const { return view(); }
+
+		static String borrow(std::string_view text);
+	};
+
+	inline bool operator==(const String& a, const String& b)
+	{
+		return a.view() == b.view();
+	}
+
+	inline bool operator!=(const String& a, const String& b)
+	{
+		return !(a == b);
+	}
+
+	// The String operand is deduced rather than converted to so that these
+	// overloads never compete with comparisons between other string types.
+	template <typename S, typename T>
+	using StringComparison = std::enable_if_t<std::is_same_v<S, String> && std::is_convertible_v<const T&, std::string_view>, bool>;
+
+	template <typename S, typename T>
+	StringComparison<S, T> operator==(const S& a, const T& b)
+	{
+		return a.view() == std::string_view(b);
+	}
+
+	template <typename T, typename S>
+	StringComparison<S, T> operator==(const T& a, const S& b)
+	{
+		return std::string_view(a) == b.view();
+	}
+
+	template <typename S, typename T>
+	StringComparison<S, T> operator!=(const S& a, const T& b)
+	{
+		return !(a == b);
+	}
+
+	template <typename T, typename S>
+	StringComparison<S, T> operator!=(const T& a, const S& b)
+	{
+		return !(a == b);
+	}
+
+	std::ostream& operator<<(std::ostream& out, const String& string);
+}
+
+namespace std
+{
+	template <>
+	struct hash<hirzel::json::String>
+	{
+		size_t operator()(const hirzel::json::String& string) const noexcept
+		{
+			return hash<string_view>()(string.view());
+		}
+	};
+}
+
+#endif
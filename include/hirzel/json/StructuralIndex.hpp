@@ -0,0 +1,44 @@
+#ifndef HIRZEL_JSON_STRUCTURAL_INDEX_HPP
+#define HIRZEL_JSON_STRUCTURAL_INDEX_HPP
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace hirzel::json
+{
+	enum class ScannerType: unsigned char
+	{
+		Scalar,
+		Sse42,
+		Avx2
+	};
+
+	bool isScannerSupported(ScannerType scannerType);
+	ScannerType bestScannerType();
+	const char* scannerTypeName(ScannerType scannerType);
+
+	// Positions of the first character of every token in a JSON text,
+	// found 64 bytes at a time. Strings contribute the positions of both
+	// their opening and closing quotes so that their length is known without
+	// scanning them again. The parser visits these positions instead of
+	// skipping whitespace byte by byte.
+	class StructuralIndex
+	{
+		std::vector<uint32_t> _positions;
+
+	public:
+
+		// Returns nothing if the text cannot be indexed, which is the case
+		// for texts containing comments or unterminated strings and for texts
+		// larger than 4 GiB. Such texts are tokenized without an index.
+		static std::optional<StructuralIndex> build(const char* src, size_t length);
+		static std::optional<StructuralIndex> build(const char* src, size_t length, ScannerType scannerType);
+
+		const auto& positions() const { return _positions; }
+		size_t size() const { return _positions.size(); }
+		uint32_t operator[](size_t i) const { return _positions[i]; }
+	};
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef HIRZEL_JSON_THREAD_POOL_HPP
+#define HIRZEL_JSON_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hirzel::json
+{
+	// Fixed set of worker threads that run submitted tasks in order. Tasks
+	// must not throw.
+	class ThreadPool
+	{
+		std::vector<std::thread> _threads;
+		std::deque<std::function<void()>> _tasks;
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		bool _isStopping;
+
+		void work();
+
+	public:
+
+		// A thread count of 0 uses one thread per hardware thread.
+		explicit ThreadPool(size_t threadCount = 0);
+		ThreadPool(ThreadPool&&) = delete;
+		ThreadPool(const ThreadPool&) = delete;
+		~ThreadPool();
+
+		ThreadPool& operator=(ThreadPool&&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		void submit(std::function<void()>&& task);
+
+		// Runs task(i) for every i below count and returns once all of them
+		// have finished. The calling thread takes part, claiming indices one
+		// at a time like the workers, so this may be called from a task
+		// without waiting on workers that are busy.
+		void parallelFor(size_t count, const std::function<void(size_t i)>& task);
+
+		size_t threadCount() const { return _threads.size(); }
+
+		// Pool shared by the parallel functions of the library unless they
+		// are given another.
+		static ThreadPool& shared();
+	};
+}
+
+#endif
@@ -1,44 +1,53 @@
 #ifndef HIRZEL_JSON_TOKEN_HPP
 #define HIRZEL_JSON_TOKEN_HPP
 
+#include "hirzel/json/ParseError.hpp"
 #include "hirzel/json/TokenType.hpp"
 
 #include <optional>
 #include <string>
+#include <string_view>
 
 namespace hirzel::json
 {
+	// A token in a text of known length. The text does not need to be
+	// terminated.
 	class Token
 	{
 		const char* _src;
+		size_t _srcLength;
 		size_t _index;
 		size_t _length;
 		TokenType _type;
 
 	private:
 
-		Token(const char* src, size_t index, size_t length, TokenType type);
-
-		static std::optional<Token> parse(const char *src, size_t index);
-		static std::optional<Token> parseString(const char *src, size_t index);
-		static std::optional<Token> parseNumber(const char *src, size_t index);
-		static std::optional<Token> parseTrue(const char *src, size_t index);
-		static std::optional<Token> parseFalse(const char *src, size_t index);
-		static std::optional<Token> parseNull(const char *src, size_t index);
+		static std::optional<Token> parseString(const char* src, size_t srcLength, size_t index, ParseError* error);
+		static std::optional<Token> parseNumber(const char* src, size_t srcLength, size_t index, ParseError* error);
+		static std::optional<Token> parseTrue(const char* src, size_t srcLength, size_t index, ParseError* error);
+		static std::optional<Token> parseFalse(const char* src, size_t srcLength, size_t index, ParseError* error);
+		static std::optional<Token> parseNull(const char* src, size_t srcLength, size_t index, ParseError* error);
 
 	public:
 
+		Token(const char* src, size_t srcLength, size_t index, size_t length, TokenType type);
 		Token(Token&&) = default;
 		Token(const Token&) = default;
 		Token& operator=(Token&&) = default;
 		Token& operator=(const Token&) = default;
 
-		static std::optional<Token> parse(const char* src);
-		std::optional<Token> parseNext() const;
+		// Errors are recorded in error if one is given, and otherwise passed
+		// to the callback set with onError.
+		static std::optional<Token> parse(const char* src, ParseError* error = nullptr);
+		static std::optional<Token> parse(const char* src, size_t srcLength, ParseError* error = nullptr);
+		static std::optional<Token> parseAt(const char* src, size_t srcLength, size_t index, ParseError* error = nullptr);
+		std::optional<Token> parseNext(ParseError* error = nullptr) const;
 
 		std::string text() const;
+		std::string_view view() const { return { _src + _index, _length }; }
 
 		const auto* src() const { return _src; }
+		const auto& srcLength() const { return _srcLength; }
 		const auto& index() const { return _index; }
 		const auto& length() const { return _length; }
 		const auto& type() const { return _type; }
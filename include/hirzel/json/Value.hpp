@@ -1,9 +1,16 @@
 #ifndef HIRZEL_JSON_VALUE_HPP
 #define HIRZEL_JSON_VALUE_HPP
 
+#include "hirzel/json/Arena.hpp"
+#include "hirzel/json/Object.hpp"
+#include "hirzel/json/String.hpp"
 #include "hirzel/json/ValueType.hpp"
 
+#include <atomic>
+#include <memory_resource>
+#include <new>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 #include <iostream>
@@ -14,20 +21,84 @@ namespace hirzel::json
 {
 	class Value;
 
-	using Object = std::unordered_map<std::string, Value>;
-	using Array = std::vector<Value>;
+	// Containers carry a polymorphic allocator so that a document can place
+	// them in its Arena. Default constructed containers use the heap.
+	using Array = std::pmr::vector<Value>;
+
+	// Allocation holding a value's container. Copies of a value share the
+	// node of a heap allocated container and count their references to it.
+	// The first mutable access through a copy whose node is shared clones
+	// the container, whose children are shared in turn, so copying is
+	// constant time and mutating clones only the path to the change.
+	// Containers in an Arena are never shared, as copies must not depend
+	// on the arena, and are copied instead.
+	template <typename Container>
+	struct ContainerNode
+	{
+		std::atomic<uint32_t> referenceCount;
+		bool isShareable;
+		// Set on the root of a parsed document, whose tree is then entirely
+		// in the arena. Mutable access clears it, as it may add values that
+		// are not.
+		bool isSealed;
+		Container container;
+
+		ContainerNode(Container&& container, bool isShareable):
+			referenceCount(1),
+			isShareable(isShareable),
+			isSealed(false),
+			container(std::move(container))
+		{}
+
+		ContainerNode(const Container& container, std::pmr::memory_resource* resource):
+			referenceCount(1),
+			isShareable(true),
+			isSealed(false),
+			container(container, resource)
+		{}
+	};
 
 	class Value
 	{
+		static constexpr size_t inlineStringCapacity = 14;
+		static constexpr size_t stringLengthOffset = 8;
+		static constexpr unsigned char integerTag = 1;
+		static constexpr unsigned char ownedStringTag = 0xFE;
+		static constexpr unsigned char borrowedStringTag = 0xFF;
+
+		// Booleans, numbers and container pointers are placed at the start of
+		// the storage. Strings of up to inlineStringCapacity characters are
+		// kept in the storage itself. Longer strings keep a pointer to their
+		// characters at the start and their length at stringLengthOffset.
+		alignas(8) char _storage[inlineStringCapacity];
+		// For numbers, integerTag if the number was written as an integer and
+		// is kept as int64_t so that it round-trips exactly. For strings, the
+		// length of an inline string or where a longer string's characters
+		// are kept.
+		unsigned char _tag;
 		ValueType _type;
-		union
-		{
-			bool _boolean;
-			double _number;
-			std::string* _string;
-			Array* _array;
-			Object* _object;
-		};
+
+		template <typename T, size_t offset = 0>
+		T& field() { return *std::launder(reinterpret_cast<T*>(_storage + offset)); }
+
+		template <typename T, size_t offset = 0>
+		const T& field() const { return *std::launder(reinterpret_cast<const T*>(_storage + offset)); }
+
+		template <typename T, size_t offset = 0>
+		void setField(T value) { new (_storage + offset) T(value); }
+
+		bool isInlineString() const { return _tag <= inlineStringCapacity; }
+		void setString(std::string_view text);
+		void setBorrowedString(std::string_view text);
+		void takeNestedContainers(std::vector<Value>& pending);
+
+		// For a Document, which releases a sealed tree with its arena instead
+		// of destroying each of its nodes.
+		void seal();
+		bool isSealed() const;
+		void forget() { _type = ValueType::Null; }
+
+		friend class Document;
 
 	public:
 
@@ -44,10 +115,14 @@ namespace hirzel::json
 		Value(float d);
 		Value(double d);
 		Value(bool b);
+		Value(String&& s);
+		Value(const String& s);
+		Value(std::string_view s);
 		Value(std::string&& s);
 		Value(const std::string& s);
 		Value(char* s);
 		Value(const char* s);
+		Value(std::string_view s, Arena& arena);
 		Value(Array&& array);
 		Value(const Array& array);
 		Value(Object&& object);
@@ -80,30 +155,60 @@ namespace hirzel::json
 			return out;
 		}
 
-		double& number() { assert(_type == ValueType::Number); return _number; }
-		const double& number() const { assert(_type == ValueType::Number); return _number; }
+		// Refers to the text instead of copying it, so the text must outlive
+		// the value and its moved-to values. Short strings are copied inline
+		// regardless.
+		static Value borrow(std::string_view s);
+
+		double number() const { assert(_type == ValueType::Number); return _tag == integerTag ? (double)field<int64_t>() : field<double>(); }
+		int64_t integer() const { assert(_type == ValueType::Number); return _tag == integerTag ? field<int64_t>() : (int64_t)field<double>(); }
 
-		bool& boolean() { assert(_type == ValueType::Boolean); return _boolean; }
-		const bool& boolean() const { assert(_type == ValueType::Boolean); return _boolean; }
+		bool& boolean() { assert(_type == ValueType::Boolean); return field<bool>(); }
+		const bool& boolean() const { assert(_type == ValueType::Boolean); return field<bool>(); }
 
-		std::string& string() { assert(_type == ValueType::String); return *_string; }
-		const std::string& string() const { assert(_type == ValueType::String); return *_string; }
+		// Strings may be kept inline, in a document's arena or in the input,
+		// so they are only read through a view. A string is changed by
+		// assigning a new one to the value.
+		std::string_view string() const
+		{
+			assert(_type == ValueType::String);
+
+			return isInlineString()
+				? std::string_view(_storage, _tag)
+				: std::string_view(field<const char*>(), field<uint32_t, stringLengthOffset>());
+		}
+
+		bool isBorrowedString() const { return _type == ValueType::String && _tag == borrowedStringTag; }
+
+		// Mutable access clones the container first if it is shared with
+		// copies of the value. References obtained this way must not be kept
+		// across copying the value, as the copy then shares what they refer
+		// to.
+		Array& array();
+		const Array& array() const { assert(_type == ValueType::Array); return field<ContainerNode<Array>*>()->container; }
 
-		auto& array() { assert(_type == ValueType::Array); return *_array; }
-		const auto& array() const { assert(_type == ValueType::Array); return *_array; }
+		Object& object();
+		const Object& object() const { assert(_type == ValueType::Object); return field<ContainerNode<Object>*>()->container; }
 
-		auto& object() { assert(_type == ValueType::Object); return *_object; }
-		const auto& object() const { assert(_type == ValueType::Object); return *_object; }
+		// Whether the value's container is shared with copies of the value.
+		bool isShared() const;
 
 		int64_t asInteger() const;
 		double asDecimal() const;
 		bool asBoolean() const;
 		std::string	asString() const;
 
-		bool contains(const std::string& key) const
+		bool contains(std::string_view key) const
+		{
+			return _type == ValueType::Object ?
+				object().contains(key) :
+				false;
+		}
+
+		bool contains(const Key& key) const
 		{
 			return _type == ValueType::Object ?
-				_object->find(key) != _object->end() :
+				object().contains(key) :
 				false;
 		}
 
@@ -111,6 +216,7 @@ namespace hirzel::json
 		bool isNull() const { return _type == ValueType::Null; }
 		bool isDecimal() const { return _type == ValueType::Number; }
 		bool isNumber() const { return _type == ValueType::Number; }
+		bool isInteger() const { return _type == ValueType::Number && _tag == integerTag; }
 		bool isBoolean() const { return _type == ValueType::Boolean; }
 		bool isString() const { return _type == ValueType::String; }
 		bool isArray() const { return _type == ValueType::Array; }
@@ -127,10 +233,16 @@ namespace hirzel::json
 		Value& operator[](size_t i);
 		const Value& operator[](size_t i) const;
 
-		Value *at(const std::string& key);
-		const Value *at(const std::string& key) const;
-		Value& operator[](const std::string& key);
-		const Value& operator[](const std::string& key) const;
+		// Keys are looked up without being copied. A Key also saves hashing
+		// the key when the object is large enough to be indexed.
+		Value *at(std::string_view key);
+		const Value *at(std::string_view key) const;
+		Value *at(const Key& key);
+		const Value *at(const Key& key) const;
+		Value& operator[](std::string_view key);
+		const Value& operator[](std::string_view key) const;
+		Value& operator[](const Key& key);
+		const Value& operator[](const Key& key) const;
 
 		bool operator==(const Value& other) const;
 		bool operator!=(const Value& other) const { return !(*this == other); }
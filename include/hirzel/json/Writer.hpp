@@ -0,0 +1,154 @@
+#ifndef HIRZEL_JSON_WRITER_HPP
+#define HIRZEL_JSON_WRITER_HPP
+
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace hirzel::json
+{
+	// Buffered output for the serializer. Text is appended to a buffer that
+	// is handed to the sink when it fills up and when the writer is flushed.
+	// Once the sink fails, further output is dropped and isFailed() is true.
+	class Writer
+	{
+		char* _begin;
+		char* _position;
+		char* _end;
+		bool _isFailed;
+
+		bool writeSlow(const char* data, size_t length);
+
+	protected:
+
+		Writer();
+		Writer(char* begin, char* end);
+
+		void setBuffer(char* begin, char* end, size_t length);
+		char* begin() const { return _begin; }
+		char* position() const { return _position; }
+
+		// Makes room for more text, by default by draining the buffer.
+		// Returns false if no room could be made.
+		virtual bool overflow(size_t length);
+		virtual bool drain(const char* data, size_t length) = 0;
+
+	public:
+
+		Writer(const Writer&) = delete;
+		Writer& operator=(const Writer&) = delete;
+		virtual ~Writer() = default;
+
+		bool write(char c)
+		{
+			if (_position == _end)
+				return writeSlow(&c, 1);
+
+			*_position++ = c;
+			return true;
+		}
+
+		bool write(const char* data, size_t length)
+		{
+			if ((size_t)(_end - _position) < length)
+				return writeSlow(data, length);
+
+			memcpy(_position, data, length);
+			_position += length;
+			return true;
+		}
+
+		bool write(std::string_view text) { return write(text.data(), text.length()); }
+
+		// Returns space for at least `length` characters directly in the
+		// buffer, or nullptr if the buffer cannot hold that many, in which
+		// case the text is passed to write() instead. The buffer is only
+		// made room in once it is full. The text written there is kept by
+		// passing its end to commit().
+		char* reserve(size_t length);
+		void commit(char* end) { _position = end; }
+
+		virtual bool flush();
+
+		bool isFailed() const { return _isFailed; }
+	};
+
+	// Appends to a single growable string.
+	class StringWriter: public Writer
+	{
+		std::string _text;
+
+	protected:
+
+		bool overflow(size_t length) override;
+		bool drain(const char* data, size_t length) override;
+
+	public:
+
+		StringWriter();
+		explicit StringWriter(size_t capacity);
+
+		bool flush() override;
+		std::string release();
+	};
+
+	// Writes to a std::ostream through a fixed buffer.
+	class StreamWriter: public Writer
+	{
+		std::ostream& _out;
+		char _buffer[4096];
+
+	protected:
+
+		bool drain(const char* data, size_t length) override;
+
+	public:
+
+		explicit StreamWriter(std::ostream& out);
+		~StreamWriter();
+	};
+
+	// Writes to a file descriptor, such as a file or socket, through a fixed
+	// buffer. The descriptor is not closed.
+	class FileDescriptorWriter: public Writer
+	{
+		int _fd;
+		char _buffer[4096];
+
+	protected:
+
+		bool drain(const char* data, size_t length) override;
+
+	public:
+
+		explicit FileDescriptorWriter(int fd);
+		~FileDescriptorWriter();
+	};
+
+	// Writes into a caller-owned buffer. Whenever the buffer is full, and on
+	// flush, its contents are passed to the overflow callback, after which
+	// the buffer is reused. Without a callback, or if the callback returns
+	// false, output that does not fit fails the writer.
+	class SpanWriter: public Writer
+	{
+		std::function<bool(const char* data, size_t length)> _onOverflow;
+
+	protected:
+
+		bool drain(const char* data, size_t length) override;
+
+	public:
+
+		SpanWriter(char* buffer, size_t size, std::function<bool(const char* data, size_t length)> onOverflow = nullptr);
+		~SpanWriter();
+
+		bool flush() override;
+
+		// Characters in the buffer that have not been passed to the callback.
+		size_t length() const { return position() - begin(); }
+	};
+}
+
+#endif
@@ -0,0 +1,17 @@
+#include "hirzel/json/Arena.hpp"
+
+namespace hirzel::json
+{
+	Arena::Arena():
+		_resource()
+	{}
+
+	Arena::Arena(size_t initialSize):
+		_resource(initialSize > 0 ? initialSize : 1)
+	{}
+
+	void* Arena::allocate(size_t size, size_t alignment)
+	{
+		return _resource.allocate(size, alignment);
+	}
+}
@@ -1,23 +1,130 @@
 #include "hirzel/json/Deserialization.hpp"
-#include "hirzel/json/Error.hpp"
+#include "hirzel/json/Escape.hpp"
+#include "hirzel/json/ParseError.hpp"
+#include "hirzel/json/Number.hpp"
+#include "hirzel/json/StructuralIndex.hpp"
 #include "hirzel/json/Token.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <utility>
 #include <cstdlib>
+#include <cstring>
+#include <vector>
 
 namespace hirzel::json
 {
-	std::optional<Value> deserializeValue(Token& token);
-	std::optional<Value> deserializeObject(Token& token);
-	std::optional<Value> deserializeArray(Token& token);
-	std::optional<Value> deserializeString(Token& token);
-	std::optional<Value> deserializeNumber(Token& token);
-	std::optional<Value> deserializeBoolean(Token& token);
-	std::optional<Value> deserializeNull(Token& token);
+	// Container that is being parsed.
+	struct Frame
+	{
+		bool isObject;
+		// Size of the scratch stack of the container's children when the
+		// container started.
+		size_t start;
+	};
+
+	struct Context
+	{
+		Arena* arena = nullptr;
+		KeyPool* keyPool = nullptr;
+		bool borrowStrings = false;
+		const StructuralIndex* index = nullptr;
+		size_t nextPosition = 0;
+		size_t length = 0;
+		// Children of the containers being parsed, innermost last. They
+		// are moved out when their container ends, so that its storage is
+		// allocated once and at its exact size.
+		std::vector<Value> values;
+		std::vector<Object::value_type> members;
+		// Containers being parsed, innermost last, so that nesting does not
+		// use the call stack.
+		std::vector<Frame> frames;
+		size_t maxDepth = 0;
+		// Where to record an error instead of passing it to the callback.
+		ParseError* error = nullptr;
+		// Strings with escape sequences that are not decoded into an arena
+		// are decoded here and copied out.
+		std::string scratch;
+	};
+
+	// Each function parses the value starting at the token into out and
+	// returns false on failure, so values are moved into their parent
+	// without passing through an optional on every level.
+	bool deserializeValue(Token& token, Context& context, Value& out);
+	bool deserializeString(Token& token, Context& context, Value& out);
+	bool deserializeNumber(Token& token, Context& context, Value& out);
+	bool deserializeBoolean(Token& token, Context& context, Value& out);
+	bool deserializeNull(Token& token, Context& context, Value& out);
+
+	static bool isDelimiter(char c)
+	{
+		switch (c)
+		{
+			case '{':
+			case '}':
+			case '[':
+			case ']':
+			case ':':
+			case ',':
+			case '\"':
+				return true;
+
+			case '\0':
+				return false;
+
+			default:
+				return (unsigned char)c <= ' ';
+		}
+	}
+
+	static std::optional<Token> parseIndexedToken(const char* src, Context& context)
+	{
+		const auto& index = *context.index;
+		auto position = context.nextPosition < index.size()
+			? (size_t)index[context.nextPosition]
+			: context.length;
+
+		context.nextPosition += 1;
+
+		if (position >= context.length || src[position] != '\"')
+			return Token::parseAt(src, context.length, position, context.error);
+
+		auto endPosition = (size_t)index[context.nextPosition];
+
+		context.nextPosition += 1;
+
+		return Token(src, context.length, position, endPosition - position + 1, TokenType::String);
+	}
 
-	static bool incrementToken(Token& token)
+	static bool incrementToken(Token& token, Context& context)
 	{
-		auto nextToken = token.parseNext();
+		if (context.index)
+		{
+			// The index only records where tokens start, so a scalar that runs
+			// into other characters, such as '123abc', is handed back to the
+			// tokenizer to report the error.
+			switch (token.type())
+			{
+				case TokenType::Number:
+				case TokenType::True:
+				case TokenType::False:
+				case TokenType::Null:
+				{
+					auto end = token.index() + token.length();
+
+					if (end < context.length && !isDelimiter(token.src()[end]))
+						context.index = nullptr;
+					break;
+				}
+
+				default:
+					break;
+			}
+		}
+
+		auto nextToken = context.index
+			? parseIndexedToken(token.src(), context)
+			: token.parseNext(context.error);
 
 		if (!nextToken)
 			return false;
@@ -27,232 +134,705 @@ namespace hirzel::json
 		return true;
 	}
 
-	static void expectedError(const Token& token, const char *expected)
+	static void expectedError(const Token& token, const Context& context, const char *expected)
+	{
+		reportError(context.error, ParseError(ErrorCode::UnexpectedToken, token.src(), token.srcLength(), token.index(), token.length(), expected));
+	}
+
+	static std::string_view stringText(const Token& token)
+	{
+		return token.view().substr(1, token.length() - 2);
+	}
+
+	static bool hasEscapes(std::string_view text)
+	{
+		return memchr(text.data(), '\\', text.length()) != nullptr;
+	}
+
+	// Decodes the escape sequences of a string token into the arena, if one
+	// is given, and otherwise into the context's scratch buffer.
+	static bool unescapeString(const Token& token, Context& context, Arena* arena, std::string_view& out)
+	{
+		auto text = stringText(token);
+		char* buffer;
+
+		if (arena)
+		{
+			buffer = (char*)arena->allocate(text.length(), 1);
+		}
+		else
+		{
+			if (context.scratch.size() < text.length())
+				context.scratch.resize(text.length());
+
+			buffer = context.scratch.data();
+		}
+
+		size_t errorOffset = 0;
+		auto length = unescape(text, buffer, errorOffset);
+
+		if (!length)
+		{
+			reportError(context.error, ParseError(ErrorCode::InvalidString, token.src(), token.srcLength(), token.index() + 1 + errorOffset, 2, "Invalid escape sequence."));
+			return false;
+		}
+
+		out = std::string_view(buffer, *length);
+
+		return true;
+	}
+
+	static bool createKey(const Token& token, Context& context, String& out)
+	{
+		auto text = stringText(token);
+
+		if (hasEscapes(text))
+		{
+			// Interned keys are copied into the pool, so they are decoded
+			// into the scratch buffer.
+			auto* arena = context.keyPool
+				? nullptr
+				: context.arena;
+
+			if (!unescapeString(token, context, arena, text))
+				return false;
+
+			if (context.keyPool)
+			{
+				out = context.keyPool->intern(text);
+			}
+			else if (arena)
+			{
+				out = String::borrow(text);
+			}
+			else
+			{
+				out = String(text);
+			}
+
+			return true;
+		}
+
+		if (context.keyPool)
+		{
+			out = context.keyPool->intern(text);
+		}
+		else if (context.borrowStrings)
+		{
+			out = String::borrow(text);
+		}
+		else if (context.arena)
+		{
+			out = String(text, *context.arena);
+		}
+		else
+		{
+			out = String(text);
+		}
+
+		return true;
+	}
+
+	// Values keep short strings inline, so they are created directly from
+	// the text instead of through a String. Strings with escape sequences
+	// are never borrowed, and in a document they are decoded straight into
+	// the arena.
+	static bool createStringValue(const Token& token, Context& context, Value& out)
 	{
-		if (!hasErrorCallback())
-			return;
+		auto text = stringText(token);
+
+		if (hasEscapes(text))
+		{
+			if (!unescapeString(token, context, context.arena, text))
+				return false;
+
+			out = context.arena
+				? Value::borrow(text)
+				: Value(text);
 
-		auto message = std::string();
+			return true;
+		}
 
-		message += "Unable to deserialize value: Expected ";
-		message += expected;
-		message += ", but got '";
-		message += token.text();
-		message += "'.";
+		if (context.borrowStrings)
+		{
+			out = Value::borrow(text);
+		}
+		else if (context.arena)
+		{
+			out = Value(text, *context.arena);
+		}
+		else
+		{
+			out = Value(text);
+		}
 
-		pushError(message);
+		return true;
 	}
 
-	std::optional<Value> deserialize(const char* json)
+	static std::optional<Value> deserializeRoot(const char* json, size_t length, Context& context)
 	{
-		auto token = Token::parse(json);
+		auto index = StructuralIndex::build(json, length);
+
+		context.index = index
+			? &*index
+			: nullptr;
+		context.length = length;
+
+		auto token = context.index
+			? parseIndexedToken(json, context)
+			: Token::parse(json, length, context.error);
 
 		if (!token)
 			return {};
 
-		auto out = deserializeValue(*token);
+		auto out = Value();
 
-		if (!out)
+		if (!deserializeValue(*token, context, out))
 			return {};
 
 		if (token->type() != TokenType::EndOfFile)
 		{
-			expectedError(*token, "end of file");
+			expectedError(*token, context, "end of file");
 			return {};
 		}
 
 		return out;
 	}
 
-	std::optional<Value> deserialize(const std::string& json)
+	std::optional<Value> deserialize(const char* json, size_t length, const DeserializationOptions& options)
 	{
-		return deserialize(json.c_str());
+		auto context = Context();
+
+		context.keyPool = options.keyPool;
+		context.borrowStrings = options.borrowStrings;
+		context.maxDepth = options.maxDepth;
+		context.error = options.error;
+
+		return deserializeRoot(json, length, context);
 	}
 
-	std::optional<Value> deserializeValue(Token& token)
+	std::optional<Value> deserialize(std::string_view json, const DeserializationOptions& options)
 	{
-		switch (token.type())
-		{
-			case TokenType::LeftBrace:
-				return deserializeObject(token);
+		return deserialize(json.data(), json.length(), options);
+	}
+
+	std::optional<Value> deserialize(const char* json, const DeserializationOptions& options)
+	{
+		return deserialize(json, strlen(json), options);
+	}
+
+	std::optional<Value> deserialize(const std::string& json, const DeserializationOptions& options)
+	{
+		return deserialize(json.data(), json.length(), options);
+	}
 
-			case TokenType::LeftBracket:
-				return deserializeArray(token);
+	std::optional<Document> deserializeDocument(const char* json, size_t length, const DeserializationOptions& options)
+	{
+		// Sizing the first block from the input keeps most documents in one
+		// contiguous allocation. Borrowed strings are not copied into the
+		// arena, so less of it is needed.
+		auto arenaSize = options.borrowStrings
+			? length
+			: length * 2;
+		auto document = Document(arenaSize);
+		auto context = Context();
+
+		context.arena = &document.arena();
+		context.borrowStrings = options.borrowStrings;
+		context.maxDepth = options.maxDepth;
+		context.error = options.error;
+
+		if (options.keyPool)
+		{
+			context.keyPool = options.keyPool;
+		}
+		else if (options.internKeys)
+		{
+			context.keyPool = &document.keyPool();
+		}
 
-			case TokenType::String:
-				return deserializeString(token);
+		auto root = deserializeRoot(json, length, context);
 
-			case TokenType::Number:
-				return deserializeNumber(token);
+		if (!root)
+			return {};
 
-			case TokenType::True:
-			case TokenType::False:
-				return deserializeBoolean(token);
+		document.root() = std::move(*root);
+		document.sealRoot();
 
-			case TokenType::Null:
-				return deserializeNull(token);
+		return document;
+	}
 
-			default:
-				break;
-		}
+	std::optional<Document> deserializeDocument(std::string_view json, const DeserializationOptions& options)
+	{
+		return deserializeDocument(json.data(), json.length(), options);
+	}
 
-		expectedError(token, "object, array, string, number, boolean, or null");
+	std::optional<Document> deserializeDocument(const char* json, const DeserializationOptions& options)
+	{
+		return deserializeDocument(json, strlen(json), options);
+	}
 
-		return {};
+	std::optional<Document> deserializeDocument(const std::string& json, const DeserializationOptions& options)
+	{
+		return deserializeDocument(json.data(), json.length(), options);
 	}
 
-	std::optional<Value> deserializeObject(Token& token)
+	std::optional<Document> deserializeFile(const char* path, const DeserializationOptions& options)
 	{
-		if (token.type() != TokenType::LeftBrace)
-		{
-			expectedError(token, "'{'");
+		auto file = MappedFile::open(path, options.error);
+
+		if (!file)
 			return {};
-		}
 
-		if (!incrementToken(token))
+		auto document = deserializeDocument(file->data(), file->length(), options);
+
+		if (document && options.borrowStrings)
+			document->setSource(std::move(*file));
+
+		// The error would otherwise refer to the mapping, which is released
+		// on return.
+		if (!document && options.error)
+			options.error->detachSource();
+
+		return document;
+	}
+
+	std::optional<Document> deserializeFile(const std::string& path, const DeserializationOptions& options)
+	{
+		return deserializeFile(path.c_str(), options);
+	}
+
+	struct ArrayElements
+	{
+		// Index entries of the first token of each element and of the ','
+		// or ']' that follows it.
+		std::vector<size_t> starts;
+		std::vector<size_t> ends;
+	};
+
+	// Finds the top-level elements of a root array by walking the index,
+	// which is much cheaper than parsing them. Returns nothing if the root
+	// is not an array or the text does not end with it.
+	static std::optional<ArrayElements> findArrayElements(const char* json, const StructuralIndex& index)
+	{
+		if (index.size() < 2 || json[index[0]] != '[')
 			return {};
 
-		auto object = Object();
+		auto elements = ArrayElements();
+		size_t depth = 1;
 
-		if (token.type() != TokenType::RightBrace)
+		for (size_t i = 1; i < index.size(); ++i)
 		{
-			while (true)
+			switch (json[index[i]])
 			{
-				if (token.type() != TokenType::String)
-				{
-					expectedError(token, "label");
-					return {};
-				}
+				case '\"':
+					// Skips the closing quote.
+					i += 1;
+					break;
 
-				auto label = std::string(token.src() + token.index() + 1, token.length() - 2);
+				case '[':
+				case '{':
+					depth += 1;
+					break;
 
-				if (!incrementToken(token))
-					return {};
+				case ']':
+				case '}':
+					depth -= 1;
 
-				if (token.type() != TokenType::Colon)
-				{
-					expectedError(token, "':'");
-					return {};
-				}
+					if (depth > 0)
+						break;
 
-				if (!incrementToken(token))
-					return {};
+					if (i + 1 != index.size())
+						return {};
 
-				auto value = deserializeValue(token);
+					if (i > 1)
+					{
+						elements.starts.push_back(elements.ends.empty() ? 1 : elements.ends.back() + 1);
+						elements.ends.push_back(i);
+					}
 
-				if (!value)
-					return {};
+					return elements;
 
-				object.emplace(std::move(label), *value);
+				case ',':
+					if (depth == 1)
+					{
+						elements.starts.push_back(elements.ends.empty() ? 1 : elements.ends.back() + 1);
+						elements.ends.push_back(i);
+					}
+					break;
 
-				if (token.type() == TokenType::Comma)
-				{
-					if (!incrementToken(token))
-						return {};
+				default:
+					break;
+			}
+		}
 
-					continue;
+		return {};
+	}
+
+	static std::optional<Value> deserializeElement(const char* json, size_t length, const StructuralIndex& index, size_t start, size_t end, Context& context)
+	{
+		context.index = &index;
+		context.nextPosition = start;
+		context.length = length;
+
+		auto token = parseIndexedToken(json, context);
+
+		if (!token)
+			return {};
+
+		auto value = Value();
+
+		if (!deserializeValue(*token, context, value))
+			return {};
+
+		// The element must end exactly where the pre-pass found its end.
+		if (token->index() != index[end])
+		{
+			expectedError(*token, context, json[index[end]] == ',' ? "','" : "']'");
+			return {};
+		}
+
+		return value;
+	}
+
+	std::optional<Value> deserializeParallel(const char* json, size_t length, const ParallelDeserializationOptions& options)
+	{
+		// At a maximum depth of 1 the elements cannot be containers, and the
+		// elements' limit of maxDepth - 1 would mean no limit at all.
+		if (length < options.minParallelLength || options.deserialization.maxDepth == 1)
+			return deserialize(json, length, options.deserialization);
+
+		auto index = StructuralIndex::build(json, length);
+		auto elements = index
+			? findArrayElements(json, *index)
+			: std::nullopt;
+
+		if (!elements || elements->starts.size() < 2)
+			return deserialize(json, length, options.deserialization);
+
+		auto& pool = options.pool
+			? *options.pool
+			: ThreadPool::shared();
+		auto elementCount = elements->starts.size();
+		// Several chunks per thread even out elements of different sizes.
+		auto chunkCount = std::min(elementCount, (pool.threadCount() + 1) * 4);
+		auto chunks = std::vector<std::vector<Value>>(chunkCount);
+		auto isFailed = std::atomic<bool>(false);
+		// Each chunk records its own error so that nothing is shared between
+		// threads, and workers never report errors themselves.
+		auto errors = std::vector<ParseError>(chunkCount);
+
+		pool.parallelFor(chunkCount, [&](size_t chunkIndex)
+		{
+			auto begin = elementCount * chunkIndex / chunkCount;
+			auto end = elementCount * (chunkIndex + 1) / chunkCount;
+			auto& chunk = chunks[chunkIndex];
+			// Shared by the chunk's elements so that they reuse its scratch
+			// stacks.
+			auto context = Context();
+
+			context.keyPool = options.deserialization.keyPool;
+			context.borrowStrings = options.deserialization.borrowStrings;
+			// Elements are nested in the root array.
+			context.maxDepth = options.deserialization.maxDepth > 0
+				? options.deserialization.maxDepth - 1
+				: 0;
+			context.error = &errors[chunkIndex];
+			chunk.reserve(end - begin);
+
+			for (auto i = begin; i < end && !isFailed.load(std::memory_order_relaxed); ++i)
+			{
+				auto value = deserializeElement(json, length, *index, elements->starts[i], elements->ends[i], context);
+
+				if (!value)
+				{
+					isFailed = true;
+					return;
 				}
 
-				break;
+				chunk.push_back(std::move(*value));
 			}
+		});
+
+		if (isFailed)
+		{
+			// Several chunks may have failed before they noticed the others.
+			// The earliest error in the text is reported.
+			const ParseError* first = nullptr;
 
-			if (token.type() != TokenType::RightBrace)
+			for (const auto& error : errors)
 			{
-				expectedError(token, "'}'");
-				return {};
+				if (error && (!first || error.offset() < first->offset()))
+					first = &error;
 			}
-		}
 
-		if (!incrementToken(token))
+			if (first)
+				reportError(options.deserialization.error, *first);
+
 			return {};
+		}
+
+		auto array = Array();
 
-		return object;
+		array.reserve(elementCount);
+
+		for (auto& chunk : chunks)
+		{
+			for (auto& value : chunk)
+				array.push_back(std::move(value));
+		}
+
+		return Value(std::move(array));
+	}
+
+	std::optional<Value> deserializeParallel(std::string_view json, const ParallelDeserializationOptions& options)
+	{
+		return deserializeParallel(json.data(), json.length(), options);
+	}
+
+	static void depthError(const Token& token, const Context& context)
+	{
+		reportError(context.error, ParseError(ErrorCode::DepthExceeded, token.src(), token.srcLength(), token.index(), token.length(), "Containers are nested deeper than the maximum depth."));
 	}
 
-	std::optional<Value> deserializeArray(Token& token)
+	// Parses a member's key and colon, and adds the member to the scratch
+	// stack with a placeholder for its value.
+	static bool startMember(Token& token, Context& context)
 	{
-		if (token.type() != TokenType::LeftBracket)
+		if (token.type() != TokenType::String)
 		{
-			expectedError(token, "'['");
-			return {};
+			expectedError(token, context, "label");
+			return false;
 		}
 
-		if (!incrementToken(token))
-			return {};
+		auto label = String();
+
+		if (!createKey(token, context, label))
+			return false;
+
+		if (!incrementToken(token, context))
+			return false;
+
+		if (token.type() != TokenType::Colon)
+		{
+			expectedError(token, context, "':'");
+			return false;
+		}
+
+		if (!incrementToken(token, context))
+			return false;
+
+		context.members.emplace_back(std::move(label), Value());
+
+		return true;
+	}
+
+	// Moves the innermost container's children off the scratch stack into
+	// storage reserved at their exact count.
+	static bool endContainer(Token& token, Context& context, Value& out)
+	{
+		auto frame = context.frames.back();
+
+		if (frame.isObject && token.type() != TokenType::RightBrace)
+		{
+			expectedError(token, context, "'}'");
+			return false;
+		}
+
+		if (!frame.isObject && token.type() != TokenType::RightBracket)
+		{
+			expectedError(token, context, "']'");
+			return false;
+		}
+
+		if (!incrementToken(token, context))
+			return false;
+
+		context.frames.pop_back();
+
+		auto* resource = context.arena
+			? context.arena->resource()
+			: std::pmr::get_default_resource();
+
+		if (frame.isObject)
+		{
+			auto& members = context.members;
+			auto object = Object(resource);
 
-		auto arr = Array();
+			object.reserve(members.size() - frame.start);
 
-		if (token.type() != TokenType::RightBracket)
+			for (auto i = frame.start; i < members.size(); ++i)
+				object.emplace(std::move(members[i].first), std::move(members[i].second));
+
+			members.erase(members.begin() + frame.start, members.end());
+			out = Value(std::move(object));
+		}
+		else
 		{
+			auto& values = context.values;
+			auto array = Array(resource);
+
+			array.reserve(values.size() - frame.start);
+
+			for (auto i = frame.start; i < values.size(); ++i)
+				array.push_back(std::move(values[i]));
+
+			values.erase(values.begin() + frame.start, values.end());
+			out = Value(std::move(array));
+		}
+
+		return true;
+	}
+
+	// Containers are tracked on the context's frame stack instead of by
+	// recursion, so the depth of the input only costs heap memory and is
+	// limited by maxDepth.
+	bool deserializeValue(Token& token, Context& context, Value& out)
+	{
+		auto& frames = context.frames;
+		auto base = frames.size();
+		auto value = Value();
+
+		while (true)
+		{
+			switch (token.type())
+			{
+				case TokenType::LeftBrace:
+				case TokenType::LeftBracket:
+				{
+					auto isObject = token.type() == TokenType::LeftBrace;
+					auto end = isObject
+						? TokenType::RightBrace
+						: TokenType::RightBracket;
+
+					if (context.maxDepth > 0 && frames.size() >= context.maxDepth)
+					{
+						depthError(token, context);
+						return false;
+					}
+
+					if (!incrementToken(token, context))
+						return false;
+
+					frames.push_back({ isObject, isObject ? context.members.size() : context.values.size() });
+
+					if (token.type() != end)
+					{
+						if (isObject && !startMember(token, context))
+							return false;
+
+						// Continues with the container's first child.
+						continue;
+					}
+
+					if (!endContainer(token, context, value))
+						return false;
+					break;
+				}
+
+				case TokenType::String:
+					if (!deserializeString(token, context, value))
+						return false;
+					break;
+
+				case TokenType::Number:
+					if (!deserializeNumber(token, context, value))
+						return false;
+					break;
+
+				case TokenType::True:
+				case TokenType::False:
+					if (!deserializeBoolean(token, context, value))
+						return false;
+					break;
+
+				case TokenType::Null:
+					if (!deserializeNull(token, context, value))
+						return false;
+					break;
+
+				default:
+					expectedError(token, context, "object, array, string, number, boolean, or null");
+					return false;
+			}
+
+			// Adds the finished value to its container, and ends the
+			// containers it completes, until a container has another child.
 			while (true)
 			{
-				auto value = deserializeValue(token);
+				if (frames.size() == base)
+				{
+					out = std::move(value);
+					return true;
+				}
 
-				if (!value)
-					return {};
+				auto isObject = frames.back().isObject;
 
-				arr.emplace_back(*value);
+				if (isObject)
+				{
+					context.members.back().second = std::move(value);
+				}
+				else
+				{
+					context.values.push_back(std::move(value));
+				}
 
-				if (token.type() == TokenType::Comma)
+				if (token.type() != TokenType::Comma)
 				{
-					if (!incrementToken(token))
-						return {};
+					if (!endContainer(token, context, value))
+						return false;
 
 					continue;
 				}
 
-				break;
-			}
+				if (!incrementToken(token, context))
+					return false;
 
-			if (token.type() != TokenType::RightBracket)
-			{
-				expectedError(token, "']'");
-				return {};
+				if (isObject && !startMember(token, context))
+					return false;
+
+				break;
 			}
 		}
-
-		if (!incrementToken(token))
-			return {};
-
-		return arr;
 	}
 
-	std::optional<Value> deserializeString(Token& token)
+	bool deserializeString(Token& token, Context& context, Value& out)
 	{
 		if (token.type() != TokenType::String)
 		{
-			expectedError(token, "string");
-			return {};
+			expectedError(token, context, "string");
+			return false;
 		}
 
-		auto text = std::string(token.src() + token.index() + 1, token.length() - 2);
-		auto json = Value(std::move(text));
-
-		if (!incrementToken(token))
-			return {};
+		if (!createStringValue(token, context, out))
+			return false;
 
-		return json;
+		return incrementToken(token, context);
 	}
 
-	std::optional<Value> deserializeNumber(Token& token)
+	bool deserializeNumber(Token& token, Context& context, Value& out)
 	{
 		if (token.type() != TokenType::Number)
 		{
-			expectedError(token, "number");
-			return {};
+			expectedError(token, context, "number");
+			return false;
 		}
 
-		auto text = token.text();
-		auto value = atof(text.c_str());
-		auto json = Value(value);
+		auto json = parseNumber(token.view());
 
-		if (!incrementToken(token))
-			return {};
+		if (!json)
+		{
+			reportError(context.error, ParseError(ErrorCode::NumberOutOfRange, token.src(), token.srcLength(), token.index(), token.length(), nullptr));
+
+			return false;
+		}
 
-		return json;
+		out = std::move(*json);
+
+		return incrementToken(token, context);
 	}
 
-	std::optional<Value> deserializeBoolean(Token& token)
+	bool deserializeBoolean(Token& token, Context& context, Value& out)
 	{
 		bool value;
 
@@ -267,25 +847,25 @@ namespace hirzel::json
 				break;
 
 			default:
-				expectedError(token, "boolean");
-				return {};
+				expectedError(token, context, "boolean");
+				return false;
 		}
 
-		incrementToken(token);
+		out = Value(value);
 
-		return value;
+		return incrementToken(token, context);
 	}
 
-	std::optional<Value> deserializeNull(Token& token)
+	bool deserializeNull(Token& token, Context& context, Value& out)
 	{
 		if (token.type() != TokenType::Null)
 		{
-			expectedError(token, "null");
-			return {};
+			expectedError(token, context, "null");
+			return false;
 		}
 
-		incrementToken(token);
+		out = Value();
 
-		return Value();
+		return incrementToken(token, context);
 	}
 }
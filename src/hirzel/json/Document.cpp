@@ -0,0 +1,66 @@
+#include "hirzel/json/Document.hpp"
+
+#include <utility>
+
+namespace hirzel::json
+{
+	Document::Document():
+		_source(),
+		_keyPool(),
+		_arena(std::make_unique<Arena>()),
+		_root()
+	{}
+
+	Document::Document(size_t arenaSize):
+		_source(),
+		_keyPool(),
+		_arena(std::make_unique<Arena>(arenaSize)),
+		_root()
+	{}
+
+	Document::Document(Document&& other) noexcept:
+		_source(std::move(other._source)),
+		_keyPool(std::move(other._keyPool)),
+		_arena(std::move(other._arena)),
+		_root(std::move(other._root))
+	{}
+
+	Document::~Document()
+	{
+		releaseRoot();
+	}
+
+	void Document::releaseRoot()
+	{
+		// Nothing in a sealed tree owns memory outside the arena.
+		if (_root.isSealed())
+		{
+			_root.forget();
+			return;
+		}
+
+		_root = Value();
+	}
+
+	KeyPool& Document::keyPool()
+	{
+		if (!_keyPool)
+			_keyPool = std::make_unique<KeyPool>();
+
+		return *_keyPool;
+	}
+
+	Document& Document::operator=(Document&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		releaseRoot();
+		_arena = std::move(other._arena);
+		_source = std::move(other._source);
+		_keyPool = std::move(other._keyPool);
+		_root = std::move(other._root);
+
+		return *this;
+	}
+}
@@ -0,0 +1,349 @@
+#include "hirzel/json/Escape.hpp"
+#include "hirzel/json/StructuralIndex.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HIRZEL_JSON_X86
+#include <immintrin.h>
+#endif
+
+namespace hirzel::json
+{
+	// Copies characters to out up to the next backslash and returns how
+	// many were copied. The vector versions store whole chunks before
+	// looking for a backslash in them, so they may write past the copied
+	// characters, but never further than the text's length past out.
+	using CopyRunFunction = size_t (*)(const char* src, size_t length, char* out);
+	using FindEscapableFunction = size_t (*)(const char* src, size_t length);
+
+	static bool isEscapable(char c)
+	{
+		return c == '\"' || c == '\\' || (unsigned char)c < 0x20;
+	}
+
+	static size_t copyRunScalar(const char* src, size_t length, char* out)
+	{
+		const auto* backslash = (const char*)memchr(src, '\\', length);
+		auto count = backslash
+			? (size_t)(backslash - src)
+			: length;
+
+		memcpy(out, src, count);
+
+		return count;
+	}
+
+	static size_t findEscapableScalar(const char* src, size_t length)
+	{
+		size_t i = 0;
+
+		while (i < length && !isEscapable(src[i]))
+			i += 1;
+
+		return i;
+	}
+
+#ifdef HIRZEL_JSON_X86
+
+	__attribute__((target("sse4.2")))
+	static size_t copyRunSse42(const char* src, size_t length, char* out)
+	{
+		const auto backslash = _mm_set1_epi8('\\');
+		size_t i = 0;
+
+		for (; i + 16 <= length; i += 16)
+		{
+			auto chunk = _mm_loadu_si128((const __m128i*)(src + i));
+
+			_mm_storeu_si128((__m128i*)(out + i), chunk);
+
+			if (auto mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)))
+				return i + __builtin_ctz(mask);
+		}
+
+		return i + copyRunScalar(src + i, length - i, out + i);
+	}
+
+	__attribute__((target("avx2")))
+	static size_t copyRunAvx2(const char* src, size_t length, char* out)
+	{
+		const auto backslash = _mm256_set1_epi8('\\');
+		size_t i = 0;
+
+		for (; i + 32 <= length; i += 32)
+		{
+			auto chunk = _mm256_loadu_si256((const __m256i*)(src + i));
+
+			_mm256_storeu_si256((__m256i*)(out + i), chunk);
+
+			if (auto mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, backslash)))
+				return i + __builtin_ctz(mask);
+		}
+
+		return i + copyRunScalar(src + i, length - i, out + i);
+	}
+
+	// Control characters are found as the bytes that are unchanged by
+	// taking their minimum with 0x1F.
+
+	__attribute__((target("sse4.2")))
+	static size_t findEscapableSse42(const char* src, size_t length)
+	{
+		const auto quote = _mm_set1_epi8('\"');
+		const auto backslash = _mm_set1_epi8('\\');
+		const auto control = _mm_set1_epi8(0x1F);
+		size_t i = 0;
+
+		for (; i + 16 <= length; i += 16)
+		{
+			auto chunk = _mm_loadu_si128((const __m128i*)(src + i));
+			auto escapable = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+				_mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk));
+
+			if (auto mask = (unsigned)_mm_movemask_epi8(escapable))
+				return i + __builtin_ctz(mask);
+		}
+
+		return i + findEscapableScalar(src + i, length - i);
+	}
+
+	__attribute__((target("avx2")))
+	static size_t findEscapableAvx2(const char* src, size_t length)
+	{
+		const auto quote = _mm256_set1_epi8('\"');
+		const auto backslash = _mm256_set1_epi8('\\');
+		const auto control = _mm256_set1_epi8(0x1F);
+		size_t i = 0;
+
+		for (; i + 32 <= length; i += 32)
+		{
+			auto chunk = _mm256_loadu_si256((const __m256i*)(src + i));
+			auto escapable = _mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+				_mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control), chunk));
+
+			if (auto mask = (unsigned)_mm256_movemask_epi8(escapable))
+				return i + __builtin_ctz(mask);
+		}
+
+		return i + findEscapableScalar(src + i, length - i);
+	}
+
+#endif
+
+	static CopyRunFunction copyRunFunction()
+	{
+		switch (bestScannerType())
+		{
+#ifdef HIRZEL_JSON_X86
+			case ScannerType::Sse42:
+				return copyRunSse42;
+
+			case ScannerType::Avx2:
+				return copyRunAvx2;
+#endif
+
+			default:
+				break;
+		}
+
+		return copyRunScalar;
+	}
+
+	static FindEscapableFunction findEscapableFunction()
+	{
+		switch (bestScannerType())
+		{
+#ifdef HIRZEL_JSON_X86
+			case ScannerType::Sse42:
+				return findEscapableSse42;
+
+			case ScannerType::Avx2:
+				return findEscapableAvx2;
+#endif
+
+			default:
+				break;
+		}
+
+		return findEscapableScalar;
+	}
+
+	static int hexDigit(char c)
+	{
+		if (c >= '0' && c <= '9')
+			return c - '0';
+
+		if (c >= 'a' && c <= 'f')
+			return c - 'a' + 10;
+
+		if (c >= 'A' && c <= 'F')
+			return c - 'A' + 10;
+
+		return -1;
+	}
+
+	// Reads the four hex digits of a \u sequence starting at index.
+	static bool readCodeUnit(std::string_view text, size_t index, uint32_t& out)
+	{
+		if (index + 4 > text.length())
+			return false;
+
+		out = 0;
+
+		for (size_t i = index; i < index + 4; ++i)
+		{
+			auto digit = hexDigit(text[i]);
+
+			if (digit < 0)
+				return false;
+
+			out = (out << 4) | (uint32_t)digit;
+		}
+
+		return true;
+	}
+
+	static size_t writeUtf8(uint32_t codePoint, char* out)
+	{
+		if (codePoint < 0x80)
+		{
+			out[0] = (char)codePoint;
+			return 1;
+		}
+
+		if (codePoint < 0x800)
+		{
+			out[0] = (char)(0xC0 | (codePoint >> 6));
+			out[1] = (char)(0x80 | (codePoint & 0x3F));
+			return 2;
+		}
+
+		if (codePoint < 0x10000)
+		{
+			out[0] = (char)(0xE0 | (codePoint >> 12));
+			out[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+			out[2] = (char)(0x80 | (codePoint & 0x3F));
+			return 3;
+		}
+
+		out[0] = (char)(0xF0 | (codePoint >> 18));
+		out[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+		out[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+		out[3] = (char)(0x80 | (codePoint & 0x3F));
+		return 4;
+	}
+
+	// Decodes the \u sequence at index, and the low surrogate that must
+	// follow a high one. Returns the length of the text that was read, or
+	// 0 if it is invalid.
+	static size_t readUnicodeEscape(std::string_view text, size_t index, uint32_t& codePoint)
+	{
+		if (!readCodeUnit(text, index + 2, codePoint))
+			return 0;
+
+		if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+			return 0;
+
+		if (codePoint < 0xD800 || codePoint > 0xDBFF)
+			return 6;
+
+		uint32_t low;
+
+		if (index + 8 > text.length()
+			|| text[index + 6] != '\\'
+			|| text[index + 7] != 'u'
+			|| !readCodeUnit(text, index + 8, low)
+			|| low < 0xDC00
+			|| low > 0xDFFF)
+			return 0;
+
+		codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+
+		return 12;
+	}
+
+	std::optional<size_t> unescape(std::string_view text, char* out, size_t& errorOffset)
+	{
+		static const auto copyRun = copyRunFunction();
+		size_t in = 0;
+		size_t length = 0;
+
+		while (true)
+		{
+			auto count = copyRun(text.data() + in, text.length() - in, out + length);
+
+			in += count;
+			length += count;
+
+			if (in == text.length())
+				return length;
+
+			errorOffset = in;
+
+			if (in + 1 == text.length())
+				return {};
+
+			char c;
+
+			switch (text[in + 1])
+			{
+				case '\"':
+				case '\\':
+				case '/':
+					c = text[in + 1];
+					break;
+
+				case 'b':
+					c = '\b';
+					break;
+
+				case 'f':
+					c = '\f';
+					break;
+
+				case 'n':
+					c = '\n';
+					break;
+
+				case 'r':
+					c = '\r';
+					break;
+
+				case 't':
+					c = '\t';
+					break;
+
+				case 'u':
+				{
+					uint32_t codePoint;
+					auto escapeLength = readUnicodeEscape(text, in, codePoint);
+
+					if (!escapeLength)
+						return {};
+
+					in += escapeLength;
+					length += writeUtf8(codePoint, out + length);
+					continue;
+				}
+
+				default:
+					return {};
+			}
+
+			out[length] = c;
+			length += 1;
+			in += 2;
+		}
+	}
+
+	size_t findEscapable(std::string_view text, size_t index)
+	{
+		static const auto find = findEscapableFunction();
+
+		return index + find(text.data() + index, text.length() - index);
+	}
+}
@@ -0,0 +1,54 @@
+#include "hirzel/json/EventType.hpp"
+
+namespace hirzel::json
+{
+	const char* eventTypeName(EventType eventType)
+	{
+		switch (eventType)
+		{
+			case EventType::StartObject:
+				return "start of object";
+
+			case EventType::EndObject:
+				return "end of object";
+
+			case EventType::StartArray:
+				return "start of array";
+
+			case EventType::EndArray:
+				return "end of array";
+
+			case EventType::Key:
+				return "key";
+
+			case EventType::String:
+				return "string";
+
+			case EventType::Number:
+				return "number";
+
+			case EventType::Boolean:
+				return "boolean";
+
+			case EventType::Null:
+				return "null";
+
+			case EventType::EndOfFile:
+				return "end of file";
+
+			default:
+				break;
+		}
+
+		return "invalid event";
+	}
+
+	std::ostream& operator<<(std::ostream& out, EventType eventType)
+	{
+		const auto* text = eventTypeName(eventType);
+
+		out << text;
+
+		return out;
+	}
+}
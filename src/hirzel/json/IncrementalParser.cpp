@@ -0,0 +1,504 @@
+#include "hirzel/json/IncrementalParser.hpp"
+#include "hirzel/json/Escape.hpp"
+#include "hirzel/json/Number.hpp"
+#include "hirzel/json/Token.hpp"
+
+namespace hirzel::json
+{
+	static bool isScalarEnd(char c)
+	{
+		switch (c)
+		{
+			case '{':
+			case '}':
+			case '[':
+			case ']':
+			case ':':
+			case ',':
+			case '\"':
+			case '/':
+				return true;
+
+			default:
+				return (unsigned char)c <= ' ';
+		}
+	}
+
+	IncrementalParser::IncrementalParser(const IncrementalParserOptions& options):
+		_options(options),
+		_token(),
+		_scratch(),
+		_children(),
+		_members(),
+		_frames(),
+		_values(),
+		_offset(0),
+		_line(1),
+		_column(1),
+		_tokenOffset(0),
+		_tokenLine(1),
+		_tokenColumn(1),
+		_state(State::Normal),
+		_expect(Expect::Value),
+		_isFailed(false)
+	{}
+
+	bool IncrementalParser::fail(ErrorCode code, size_t offset, size_t line, size_t column, const char* detail)
+	{
+		_isFailed = true;
+		reportError(_options.error, ParseError(code, offset, line, column, detail));
+
+		return false;
+	}
+
+	// Fails at a position in the token's text, counted from its first
+	// character, which is the opening quote for strings.
+	bool IncrementalParser::failInToken(ErrorCode code, size_t index, const char* detail)
+	{
+		auto isString = _state == State::String;
+		auto line = _tokenLine;
+		auto column = _tokenColumn;
+
+		for (size_t i = 0; i < index; ++i)
+		{
+			auto c = isString
+				? (i == 0 ? '\"' : _token[i - 1])
+				: _token[i];
+
+			if (c == '\n')
+			{
+				line += 1;
+				column = 1;
+			}
+			else
+			{
+				column += 1;
+			}
+		}
+
+		return fail(code, _tokenOffset + index, line, column, detail);
+	}
+
+	const char* IncrementalParser::expected() const
+	{
+		switch (_expect)
+		{
+			case Expect::Value:
+				return _frames.empty()
+					? "value separated by whitespace"
+					: "value";
+
+			case Expect::ValueOrEnd:
+				return "value or ']'";
+
+			case Expect::Key:
+				return "label";
+
+			case Expect::KeyOrEnd:
+				return "label or '}'";
+
+			case Expect::Colon:
+				return "':'";
+
+			default:
+				break;
+		}
+
+		return _frames.back().isObject
+			? "',' or '}'"
+			: "',' or ']'";
+	}
+
+	bool IncrementalParser::startToken(char c, State state)
+	{
+		_token.clear();
+		_tokenOffset = _offset;
+		_tokenLine = _line;
+		_tokenColumn = _column;
+		_state = state;
+
+		return state == State::String || appendToken(c);
+	}
+
+	bool IncrementalParser::appendToken(char c)
+	{
+		if (_options.maxTokenLength > 0 && _token.size() >= _options.maxTokenLength)
+			return fail(ErrorCode::LengthExceeded, _offset, _line, _column, "Token is longer than the maximum length.");
+
+		_token += c;
+
+		return true;
+	}
+
+	// Adds a finished value to its container, or to the completed values if
+	// it is not inside one.
+	bool IncrementalParser::completeValue(Value&& value)
+	{
+		if (_frames.empty())
+		{
+			_values.push_back(std::move(value));
+			_expect = Expect::Value;
+
+			return true;
+		}
+
+		if (_frames.back().isObject)
+		{
+			_members.back().second = std::move(value);
+		}
+		else
+		{
+			_children.push_back(std::move(value));
+		}
+
+		_expect = Expect::CommaOrEnd;
+
+		return true;
+	}
+
+	bool IncrementalParser::completeString()
+	{
+		if (_scratch.size() < _token.size())
+			_scratch.resize(_token.size());
+
+		size_t errorOffset = 0;
+		auto length = unescape(_token, _scratch.data(), errorOffset);
+
+		if (!length)
+			return failInToken(ErrorCode::InvalidString, errorOffset + 1, "Invalid escape sequence.");
+
+		auto text = std::string_view(_scratch.data(), *length);
+
+		_state = State::Normal;
+
+		if (_expect == Expect::Key || _expect == Expect::KeyOrEnd)
+		{
+			_members.emplace_back(String(text), Value());
+			_expect = Expect::Colon;
+
+			return true;
+		}
+
+		return completeValue(Value(text));
+	}
+
+	// Scalars are checked by the tokenizer once all of their characters
+	// have arrived.
+	bool IncrementalParser::completeScalar()
+	{
+		auto error = ParseError();
+		auto token = Token::parse(_token.data(), _token.size(), &error);
+
+		if (!token)
+			return failInToken(error.code(), error.offset(), error.detail());
+
+		if (token->length() != _token.size())
+			return failInToken(ErrorCode::InvalidCharacter, token->length(), "Invalid character.");
+
+		auto value = Value();
+
+		switch (token->type())
+		{
+			case TokenType::Number:
+			{
+				auto number = parseNumber(_token);
+
+				if (!number)
+					return failInToken(ErrorCode::NumberOutOfRange, 0, nullptr);
+
+				value = std::move(*number);
+				break;
+			}
+
+			case TokenType::True:
+				value = Value(true);
+				break;
+
+			case TokenType::False:
+				value = Value(false);
+				break;
+
+			default:
+				break;
+		}
+
+		_state = State::Normal;
+
+		return completeValue(std::move(value));
+	}
+
+	// Moves the innermost container's children off the scratch stack into
+	// storage reserved at their exact count.
+	bool IncrementalParser::endContainer(char c)
+	{
+		if (_frames.empty())
+			return fail(ErrorCode::UnbalancedBrackets, _offset, _line, _column, "Unexpected closing bracket.");
+
+		auto frame = _frames.back();
+		auto isEnd = frame.isObject
+			? c == '}' && (_expect == Expect::KeyOrEnd || _expect == Expect::CommaOrEnd)
+			: c == ']' && (_expect == Expect::ValueOrEnd || _expect == Expect::CommaOrEnd);
+
+		if (!isEnd)
+			return fail(ErrorCode::UnexpectedToken, _offset, _line, _column, expected());
+
+		_frames.pop_back();
+
+		if (frame.isObject)
+		{
+			auto object = Object();
+
+			object.reserve(_members.size() - frame.start);
+
+			for (auto i = frame.start; i < _members.size(); ++i)
+				object.emplace(std::move(_members[i].first), std::move(_members[i].second));
+
+			_members.erase(_members.begin() + frame.start, _members.end());
+
+			return completeValue(Value(std::move(object)));
+		}
+
+		auto array = Array();
+
+		array.reserve(_children.size() - frame.start);
+
+		for (auto i = frame.start; i < _children.size(); ++i)
+			array.push_back(std::move(_children[i]));
+
+		_children.erase(_children.begin() + frame.start, _children.end());
+
+		return completeValue(Value(std::move(array)));
+	}
+
+	bool IncrementalParser::consumeNormal(char c)
+	{
+		if ((unsigned char)c <= ' ')
+			return true;
+
+		auto isValueExpected = _expect == Expect::Value || _expect == Expect::ValueOrEnd;
+
+		switch (c)
+		{
+			case '/':
+				_state = State::Slash;
+				return true;
+
+			case '\"':
+				if (!isValueExpected && _expect != Expect::Key && _expect != Expect::KeyOrEnd)
+					break;
+
+				return startToken(c, State::String);
+
+			case '{':
+			case '[':
+			{
+				if (!isValueExpected)
+					break;
+
+				if (_options.maxDepth > 0 && _frames.size() >= _options.maxDepth)
+					return fail(ErrorCode::DepthExceeded, _offset, _line, _column, "Containers are nested deeper than the maximum depth.");
+
+				auto isObject = c == '{';
+
+				_frames.push_back({ isObject, isObject ? _members.size() : _children.size() });
+				_expect = isObject
+					? Expect::KeyOrEnd
+					: Expect::ValueOrEnd;
+
+				return true;
+			}
+
+			case '}':
+			case ']':
+				return endContainer(c);
+
+			case ':':
+				if (_expect != Expect::Colon)
+					break;
+
+				_expect = Expect::Value;
+				return true;
+
+			case ',':
+				if (_expect != Expect::CommaOrEnd)
+					break;
+
+				_expect = _frames.back().isObject
+					? Expect::Key
+					: Expect::Value;
+				return true;
+
+			default:
+				if (!isValueExpected)
+					break;
+
+				return startToken(c, State::Scalar);
+		}
+
+		return fail(ErrorCode::UnexpectedToken, _offset, _line, _column, expected());
+	}
+
+	bool IncrementalParser::consume(char c)
+	{
+		switch (_state)
+		{
+			case State::String:
+				if (c == '\\')
+				{
+					_state = State::StringEscape;
+					return appendToken(c);
+				}
+
+				if (c == '\"')
+					return completeString();
+
+				return appendToken(c);
+
+			case State::StringEscape:
+				_state = State::String;
+				return appendToken(c);
+
+			case State::Scalar:
+				if (!isScalarEnd(c))
+					return appendToken(c);
+
+				if (!completeScalar())
+					return false;
+
+				// The character that ended the scalar is consumed as usual.
+				return consumeNormal(c);
+
+			case State::Slash:
+				if (c == '/')
+				{
+					_state = State::LineComment;
+					return true;
+				}
+
+				if (c == '*')
+				{
+					_state = State::BlockComment;
+					return true;
+				}
+
+				// The '/' was on the same line as the character after it.
+				return fail(ErrorCode::InvalidCharacter, _offset - 1, _line, _column - 1, "Invalid character.");
+
+			case State::LineComment:
+				if (c == '\n')
+					_state = State::Normal;
+				return true;
+
+			case State::BlockComment:
+				if (c == '*')
+					_state = State::BlockCommentStar;
+				return true;
+
+			case State::BlockCommentStar:
+				if (c == '/')
+				{
+					_state = State::Normal;
+				}
+				else if (c != '*')
+				{
+					_state = State::BlockComment;
+				}
+				return true;
+
+			default:
+				break;
+		}
+
+		return consumeNormal(c);
+	}
+
+	bool IncrementalParser::feed(const char* data, size_t length)
+	{
+		if (_isFailed)
+			return false;
+
+		auto chunk = std::string_view(data, length);
+		size_t i = 0;
+
+		while (i < length)
+		{
+			if (_state == State::String)
+			{
+				// Runs of plain characters are appended at once. They contain
+				// no control characters, so the line stays the same.
+				auto end = findEscapable(chunk, i);
+				auto count = end - i;
+
+				if (_options.maxTokenLength > 0 && _token.size() + count > _options.maxTokenLength)
+					count = _options.maxTokenLength - _token.size();
+
+				_token.append(data + i, count);
+				_offset += count;
+				_column += count;
+				i += count;
+
+				if (i == length)
+					break;
+			}
+
+			auto c = data[i];
+
+			if (!consume(c))
+				return false;
+
+			_offset += 1;
+
+			if (c == '\n')
+			{
+				_line += 1;
+				_column = 1;
+			}
+			else
+			{
+				_column += 1;
+			}
+
+			i += 1;
+		}
+
+		return true;
+	}
+
+	bool IncrementalParser::finish()
+	{
+		if (_isFailed)
+			return false;
+
+		switch (_state)
+		{
+			case State::Scalar:
+				if (!completeScalar())
+					return false;
+				break;
+
+			case State::Normal:
+			case State::LineComment:
+				break;
+
+			default:
+				return fail(ErrorCode::UnexpectedEnd, _offset, _line, _column, "Input ended inside a value or comment.");
+		}
+
+		if (!_frames.empty())
+			return fail(ErrorCode::UnexpectedEnd, _offset, _line, _column, "Input ended inside a value.");
+
+		return true;
+	}
+
+	std::optional<Value> IncrementalParser::next()
+	{
+		if (_values.empty())
+			return {};
+
+		auto value = std::move(_values.front());
+
+		_values.pop_front();
+
+		return value;
+	}
+}
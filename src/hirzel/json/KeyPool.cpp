@@ -0,0 +1,49 @@
+#include "hirzel/json/KeyPool.hpp"
+
+#include <cstring>
+#include <mutex>
+
+namespace hirzel::json
+{
+	KeyPool::KeyPool():
+		_mutex(),
+		_arena(),
+		_keys()
+	{}
+
+	// Once the common keys are in the pool, lookups only take the shared
+	// lock, so parses on several threads do not serialize on it.
+	String KeyPool::intern(std::string_view key)
+	{
+		{
+			auto lock = std::shared_lock(_mutex);
+			auto iter = _keys.find(key);
+
+			if (iter != _keys.end())
+				return String::borrow(*iter);
+		}
+
+		auto lock = std::unique_lock(_mutex);
+		auto iter = _keys.find(key);
+
+		if (iter != _keys.end())
+			return String::borrow(*iter);
+
+		auto* data = (char*)_arena.allocate(key.length() ? key.length() : 1, 1);
+
+		memcpy(data, key.data(), key.length());
+
+		auto stored = std::string_view(data, key.length());
+
+		_keys.insert(stored);
+
+		return String::borrow(stored);
+	}
+
+	size_t KeyPool::size() const
+	{
+		auto lock = std::shared_lock(_mutex);
+
+		return _keys.size();
+	}
+}
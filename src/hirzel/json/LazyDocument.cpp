@@ -0,0 +1,371 @@
+#include "hirzel/json/LazyDocument.hpp"
+#include "hirzel/json/Deserialization.hpp"
+#include "hirzel/json/Escape.hpp"
+#include "hirzel/json/Number.hpp"
+
+#include <cassert>
+#include <string>
+
+namespace hirzel::json
+{
+	LazyDocument::LazyDocument(const char* src, size_t length, StructuralIndex&& index):
+		_src(src),
+		_length(length),
+		_index(std::move(index)),
+		_closers()
+	{}
+
+	std::optional<LazyDocument> LazyDocument::open(const char* src, size_t length, ParseError* error)
+	{
+		auto index = StructuralIndex::build(src, length);
+
+		if (!index)
+		{
+			reportError(error, ParseError(ErrorCode::Unindexable, src, length, 0, 0, "The text contains comments, an unterminated string or is too large to index."));
+			return {};
+		}
+
+		if (index->size() == 0)
+		{
+			reportError(error, ParseError(ErrorCode::UnexpectedToken, src, length, length, 0, "value"));
+			return {};
+		}
+
+		auto document = LazyDocument(src, length, std::move(*index));
+		auto entryCount = document._index.size();
+		auto openers = std::vector<uint32_t>();
+
+		document._closers.resize(entryCount);
+
+		for (size_t i = 0; i < entryCount; ++i)
+		{
+			switch (document.charAt(i))
+			{
+				case '\"':
+					// Skips the closing quote.
+					i += 1;
+					break;
+
+				case '{':
+				case '[':
+					openers.push_back((uint32_t)i);
+					break;
+
+				case '}':
+				case ']':
+				{
+					auto expected = document.charAt(i) == '}'
+						? '{'
+						: '[';
+
+					if (openers.empty() || document.charAt(openers.back()) != expected)
+					{
+						reportError(error, ParseError(ErrorCode::UnbalancedBrackets, src, length, document._index[i], 1, "Brackets are not balanced."));
+						return {};
+					}
+
+					document._closers[openers.back()] = (uint32_t)i;
+					openers.pop_back();
+					break;
+				}
+
+				default:
+					break;
+			}
+		}
+
+		if (!openers.empty())
+		{
+			reportError(error, ParseError(ErrorCode::UnbalancedBrackets, src, length, document._index[openers.back()], 1, "Brackets are not balanced."));
+			return {};
+		}
+
+		auto end = document.skip(0);
+
+		if (end != entryCount)
+		{
+			auto offset = document._index[end];
+
+			reportError(error, ParseError(ErrorCode::UnexpectedToken, src, length, offset, 1, "end of file"));
+			return {};
+		}
+
+		return document;
+	}
+
+	std::optional<LazyDocument> LazyDocument::open(std::string_view src, ParseError* error)
+	{
+		return open(src.data(), src.length(), error);
+	}
+
+	LazyValue LazyDocument::root() const
+	{
+		return LazyValue(*this, 0);
+	}
+
+	char LazyDocument::charAt(size_t entry) const
+	{
+		return entry < _index.size()
+			? _src[_index[entry]]
+			: '\0';
+	}
+
+	bool LazyDocument::structureError(size_t entry, const char* expected, ParseError* error) const
+	{
+		auto offset = entry < _index.size()
+			? (size_t)_index[entry]
+			: _length;
+
+		reportError(error, ParseError(ErrorCode::UnexpectedToken, _src, _length, offset, 1, expected));
+
+		return false;
+	}
+
+	size_t LazyDocument::skip(size_t entry) const
+	{
+		switch (charAt(entry))
+		{
+			case '{':
+			case '[':
+				return _closers[entry] + 1;
+
+			case '\"':
+				return entry + 2;
+
+			default:
+				return entry + 1;
+		}
+	}
+
+	LazyValue::LazyValue(const LazyDocument& document, size_t entry):
+		_document(&document),
+		_entry(entry)
+	{}
+
+	char LazyValue::firstChar() const
+	{
+		return _document->charAt(_entry);
+	}
+
+	ValueType LazyValue::type() const
+	{
+		switch (firstChar())
+		{
+			case '{':
+				return ValueType::Object;
+
+			case '[':
+				return ValueType::Array;
+
+			case '\"':
+				return ValueType::String;
+
+			case 't':
+			case 'f':
+				return ValueType::Boolean;
+
+			case 'n':
+				return ValueType::Null;
+
+			default:
+				return ValueType::Number;
+		}
+	}
+
+	std::string_view LazyValue::text() const
+	{
+		const auto& document = *_document;
+		auto start = (size_t)document._index[_entry];
+		auto end = start;
+
+		switch (firstChar())
+		{
+			case '{':
+			case '[':
+				end = document._index[document._closers[_entry]] + 1;
+				break;
+
+			case '\"':
+				end = document._index[_entry + 1] + 1;
+				break;
+
+			default:
+				// Scalars end at the next entry, less any whitespace before it.
+				end = _entry + 1 < document._index.size()
+					? document._index[_entry + 1]
+					: document._length;
+
+				while (end > start && (unsigned char)document._src[end - 1] <= ' ')
+					end -= 1;
+				break;
+		}
+
+		return std::string_view(document._src + start, end - start);
+	}
+
+	std::string_view LazyValue::string() const
+	{
+		assert(isString());
+
+		auto text = this->text();
+
+		return text.substr(1, text.length() - 2);
+	}
+
+	size_t LazyValue::length() const
+	{
+		size_t length = 0;
+
+		forEach([&](std::string_view, const LazyValue&)
+		{
+			length += 1;
+			return true;
+		});
+
+		return length;
+	}
+
+	std::optional<LazyValue> LazyValue::at(size_t i) const
+	{
+		if (!isArray())
+			return {};
+
+		auto out = std::optional<LazyValue>();
+		size_t current = 0;
+
+		auto isValid = forEach([&](std::string_view, const LazyValue& value)
+		{
+			if (current++ != i)
+				return true;
+
+			out = value;
+			return false;
+		});
+
+		if (!isValid)
+			return {};
+
+		return out;
+	}
+
+	std::optional<LazyValue> LazyValue::at(std::string_view key) const
+	{
+		if (!isObject())
+			return {};
+
+		auto out = std::optional<LazyValue>();
+		auto decoded = std::string();
+
+		auto isValid = forEach([&](std::string_view memberKey, const LazyValue& value)
+		{
+			// Escape sequences are longer than what they decode to, so only
+			// keys at least as long as the one looked up can match.
+			if (memberKey.find('\\') != std::string_view::npos && memberKey.length() >= key.length())
+			{
+				size_t errorOffset = 0;
+
+				decoded.resize(memberKey.length());
+
+				auto length = unescape(memberKey, decoded.data(), errorOffset);
+
+				if (length)
+					memberKey = std::string_view(decoded.data(), *length);
+			}
+
+			if (memberKey != key)
+				return true;
+
+			out = value;
+			return false;
+		});
+
+		if (!isValid)
+			return {};
+
+		return out;
+	}
+
+	// Members are laid out in the index as the key's opening and closing
+	// quotes, the colon and then the value's entries.
+	bool LazyValue::forEach(const std::function<bool(std::string_view key, const LazyValue& value)>& callback, ParseError* error) const
+	{
+		const auto& document = *_document;
+		auto isObject = this->isObject();
+		auto closer = isObject
+			? '}'
+			: ']';
+
+		if (!isObject && !isArray())
+			return true;
+
+		auto entry = _entry + 1;
+
+		if (document.charAt(entry) == closer)
+			return true;
+
+		while (true)
+		{
+			auto key = std::string_view();
+
+			if (isObject)
+			{
+				if (document.charAt(entry) != '\"')
+					return document.structureError(entry, "label", error);
+
+				if (document.charAt(entry + 2) != ':')
+					return document.structureError(entry + 2, "':'", error);
+
+				key = LazyValue(document, entry).string();
+				entry += 3;
+			}
+
+			if (!callback(key, LazyValue(document, entry)))
+				return true;
+
+			entry = document.skip(entry);
+
+			// Brackets are balanced, so the first closer at this level is the
+			// container's own.
+			if (document.charAt(entry) == closer)
+				return true;
+
+			if (document.charAt(entry) != ',')
+				return document.structureError(entry, isObject ? "',' or '}'" : "',' or ']'", error);
+
+			entry += 1;
+
+			if (!isObject && (document.charAt(entry) == ']' || document.charAt(entry) == ','))
+				return document.structureError(entry, "value", error);
+		}
+	}
+
+	std::optional<Value> LazyValue::value() const
+	{
+		auto text = this->text();
+
+		// Valid scalars are read directly. Everything else, including
+		// invalid scalars so that their error is reported, is deserialized.
+		switch (type())
+		{
+			case ValueType::Number:
+				if (auto number = parseNumber(text))
+					return number;
+				break;
+
+			case ValueType::Boolean:
+				if (text == "true" || text == "false")
+					return Value(text == "true");
+				break;
+
+			case ValueType::Null:
+				if (text == "null")
+					return Value();
+				break;
+
+			default:
+				break;
+		}
+
+		return deserialize(text);
+	}
+}
@@ -0,0 +1,155 @@
+#include "hirzel/json/MappedFile.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hirzel::json
+{
+	static void fileError(ParseError* error, const char* path, const char* message)
+	{
+		reportError(error, ParseError(ErrorCode::FileError, path, strlen(path), 0, strlen(path), message));
+	}
+
+	// Errors keep static descriptions only, and strerror() is neither
+	// thread-safe nor guaranteed to return text that outlives the next
+	// call, so the errors the calls report are described here.
+	static const char* systemErrorMessage(int number)
+	{
+		switch (number)
+		{
+			case ENOENT:
+				return "No such file or directory.";
+
+			case ENOTDIR:
+				return "A component of the path is not a directory.";
+
+			case EACCES:
+			case EPERM:
+				return "Permission denied.";
+
+			case ELOOP:
+				return "Too many symbolic links in the path.";
+
+			case ENAMETOOLONG:
+				return "The path is too long.";
+
+			case EMFILE:
+			case ENFILE:
+				return "Too many open files.";
+
+			case ENOMEM:
+				return "Not enough memory to map the file.";
+
+			case EOVERFLOW:
+			case EFBIG:
+				return "The file is too large.";
+
+			case ENODEV:
+				return "The file system does not support mapping.";
+
+			case EIO:
+				return "Input/output error.";
+
+			default:
+				break;
+		}
+
+		return "The file could not be opened or mapped.";
+	}
+
+	MappedFile::MappedFile(const char* data, size_t length):
+		_data(data),
+		_length(length)
+	{}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept:
+		_data(other._data),
+		_length(other._length)
+	{
+		other._data = nullptr;
+		other._length = 0;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (_length > 0)
+			munmap((void*)_data, _length);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		if (_length > 0)
+			munmap((void*)_data, _length);
+
+		_data = other._data;
+		_length = other._length;
+		other._data = nullptr;
+		other._length = 0;
+
+		return *this;
+	}
+
+	std::optional<MappedFile> MappedFile::open(const char* path, ParseError* error)
+	{
+		auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+
+		if (fd < 0)
+		{
+			fileError(error, path, systemErrorMessage(errno));
+			return {};
+		}
+
+		struct stat status;
+
+		if (fstat(fd, &status) != 0)
+		{
+			// Closing may change errno.
+			auto number = errno;
+
+			close(fd);
+			fileError(error, path, systemErrorMessage(number));
+			return {};
+		}
+
+		if (!S_ISREG(status.st_mode))
+		{
+			close(fd);
+			fileError(error, path, "Not a regular file.");
+			return {};
+		}
+
+		auto length = (size_t)status.st_size;
+
+		// Empty files cannot be mapped.
+		if (length == 0)
+		{
+			close(fd);
+			return MappedFile("", 0);
+		}
+
+		auto* data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		auto number = errno;
+
+		// The mapping keeps its own reference to the file.
+		close(fd);
+
+		if (data == MAP_FAILED)
+		{
+			fileError(error, path, systemErrorMessage(number));
+			return {};
+		}
+
+		// Advice values are not flags, so each is given separately.
+		madvise(data, length, MADV_SEQUENTIAL);
+		madvise(data, length, MADV_WILLNEED);
+
+		return MappedFile((const char*)data, length);
+	}
+}
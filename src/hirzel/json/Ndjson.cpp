@@ -0,0 +1,226 @@
+#include "hirzel/json/Ndjson.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hirzel::json
+{
+	struct NdjsonLine
+	{
+		size_t index;
+		std::string_view text;
+	};
+
+	struct NdjsonRecord
+	{
+		size_t index;
+		std::optional<Value> value;
+		ParseError error;
+	};
+
+	struct NdjsonBatch
+	{
+		std::vector<NdjsonLine> lines;
+		std::vector<NdjsonRecord> records;
+		bool isDone = false;
+	};
+
+	static const size_t minBatchSize = 16 * 1024;
+	static const size_t maxBatchSize = 1024 * 1024;
+
+	static bool isBlank(std::string_view line)
+	{
+		for (auto c : line)
+		{
+			if ((unsigned char)c > ' ')
+				return false;
+		}
+
+		return true;
+	}
+
+	// Each record gets its own error, so that workers never share one and
+	// never report errors themselves.
+	static void parseBatch(NdjsonBatch& batch, const NdjsonOptions& options)
+	{
+		auto deserializationOptions = options.deserialization;
+
+		batch.records.reserve(batch.lines.size());
+
+		for (const auto& line : batch.lines)
+		{
+			if (isBlank(line.text))
+				continue;
+
+			auto& record = batch.records.emplace_back();
+
+			record.index = line.index;
+			deserializationOptions.error = &record.error;
+			record.value = deserialize(line.text, deserializationOptions);
+		}
+	}
+
+	// Waits for the batches in flight, which refer to the stack of
+	// readNdjson, before it is released, including when a callback throws.
+	struct NdjsonInFlightGuard
+	{
+		std::deque<std::unique_ptr<NdjsonBatch>>& inFlight;
+		std::mutex& mutex;
+		std::condition_variable& condition;
+
+		~NdjsonInFlightGuard()
+		{
+			auto lock = std::unique_lock<std::mutex>(mutex);
+
+			condition.wait(lock, [&]()
+			{
+				return std::all_of(inFlight.begin(), inFlight.end(), [](const auto& batch) { return batch->isDone; });
+			});
+		}
+	};
+
+	bool readNdjson(const char* text, size_t length, const NdjsonCallback& callback, const NdjsonOptions& options)
+	{
+		auto& pool = options.pool
+			? *options.pool
+			: ThreadPool::shared();
+		// Enough batches are kept in flight to keep every thread busy while
+		// finished ones are delivered, without parsing far ahead.
+		auto maxInFlight = pool.threadCount() * 2;
+		auto batchSize = options.batchSize > 0
+			? options.batchSize
+			: std::clamp(length / (pool.threadCount() * 8), minBatchSize, maxBatchSize);
+		auto inFlight = std::deque<std::unique_ptr<NdjsonBatch>>();
+		auto mutex = std::mutex();
+		auto condition = std::condition_variable();
+		size_t position = 0;
+		size_t lineIndex = 0;
+		auto isStopped = false;
+		auto firstErrorIndex = SIZE_MAX;
+		auto guard = NdjsonInFlightGuard{ inFlight, mutex, condition };
+
+		// Records cannot contain raw newlines, so lines are found with memchr
+		// and never need to be parsed to find where they end.
+		auto submitBatch = [&]()
+		{
+			auto batch = std::make_unique<NdjsonBatch>();
+			auto batchEnd = std::min(length, position + batchSize);
+
+			while (position < length && (position < batchEnd || batch->lines.empty()))
+			{
+				const auto* newline = (const char*)memchr(text + position, '\n', length - position);
+				auto end = newline
+					? (size_t)(newline - text)
+					: length;
+
+				batch->lines.push_back({ lineIndex, std::string_view(text + position, end - position) });
+				lineIndex += 1;
+				position = end + 1;
+			}
+
+			auto* batchPtr = batch.get();
+
+			inFlight.push_back(std::move(batch));
+
+			try
+			{
+				pool.submit([&, batchPtr]()
+				{
+					parseBatch(*batchPtr, options);
+
+					auto lock = std::lock_guard<std::mutex>(mutex);
+
+					batchPtr->isDone = true;
+					condition.notify_all();
+				});
+			}
+			catch (...)
+			{
+				// The batch was never queued, so nothing will finish it.
+				inFlight.pop_back();
+				throw;
+			}
+		};
+
+		while (true)
+		{
+			while (!isStopped && position < length && inFlight.size() < maxInFlight)
+				submitBatch();
+
+			if (inFlight.empty())
+				break;
+
+			auto batch = std::unique_ptr<NdjsonBatch>();
+
+			{
+				auto lock = std::unique_lock<std::mutex>(mutex);
+
+				if (options.isOrdered)
+				{
+					condition.wait(lock, [&]() { return inFlight.front()->isDone; });
+
+					batch = std::move(inFlight.front());
+					inFlight.pop_front();
+				}
+				else
+				{
+					auto iter = inFlight.end();
+
+					condition.wait(lock, [&]()
+					{
+						iter = std::find_if(inFlight.begin(), inFlight.end(), [](const auto& batch) { return batch->isDone; });
+
+						return iter != inFlight.end();
+					});
+
+					batch = std::move(*iter);
+					inFlight.erase(iter);
+				}
+			}
+
+			// Batches still in flight after a stop are waited for, since they
+			// reference the text, but are not delivered.
+			if (isStopped)
+				continue;
+
+			for (auto& record : batch->records)
+			{
+				if (record.error)
+				{
+					if (options.errorCallback)
+						options.errorCallback(record.index, record.error);
+
+					if (options.deserialization.error && record.index < firstErrorIndex)
+					{
+						*options.deserialization.error = record.error;
+						firstErrorIndex = record.index;
+					}
+
+					// As with a single parse, the callback set with onError is
+					// only used when the caller did not ask for the error.
+					if (!options.errorCallback && !options.deserialization.error)
+						reportError(nullptr, record.error);
+				}
+
+				if (!callback(record.index, std::move(record.value)))
+				{
+					isStopped = true;
+					break;
+				}
+			}
+		}
+
+		return !isStopped;
+	}
+
+	bool readNdjson(std::string_view text, const NdjsonCallback& callback, const NdjsonOptions& options)
+	{
+		return readNdjson(text.data(), text.length(), callback, options);
+	}
+}
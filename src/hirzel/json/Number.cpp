@@ -0,0 +1,241 @@
+#include "hirzel/json/Number.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#ifndef __cpp_lib_to_chars
+#include <iomanip>
+#include <locale>
+#include <sstream>
+#include <string>
+#endif
+
+namespace hirzel::json
+{
+	// Up to 19 digits always fit in a uint64_t.
+	static const size_t maxIntegerDigits = 19;
+
+	static std::optional<Value> parseInteger(std::string_view text)
+	{
+		const auto* iter = text.data();
+		const auto* end = iter + text.size();
+		auto isNegative = false;
+
+		if (iter != end && *iter == '-')
+		{
+			isNegative = true;
+			iter += 1;
+		}
+
+		const auto* digits = iter;
+		uint64_t magnitude = 0;
+
+		while (iter != end && *iter >= '0' && *iter <= '9')
+		{
+			magnitude = magnitude * 10 + (uint64_t)(*iter - '0');
+			iter += 1;
+		}
+
+		auto digitCount = (size_t)(iter - digits);
+
+		if (iter != end || digitCount == 0 || digitCount > maxIntegerDigits)
+			return {};
+
+		if (!isNegative)
+		{
+			if (magnitude > (uint64_t)INT64_MAX)
+				return {};
+
+			return Value((int64_t)magnitude);
+		}
+
+		// -0 has no integer representation.
+		if (magnitude == 0)
+			return Value(-0.0);
+
+		if (magnitude > (uint64_t)INT64_MAX + 1)
+			return {};
+
+		return Value((int64_t)(0 - magnitude));
+	}
+
+	// Whether the text is a well-formed number whose magnitude is below
+	// 1, found from the position of its first significant digit and its
+	// exponent. Used to tell underflow, which rounds to zero, from overflow
+	// when a conversion is out of range.
+	static bool isBelowOne(std::string_view text)
+	{
+		size_t i = text.size() > 0 && text[0] == '-' ? 1 : 0;
+		long long magnitude = 0;
+		auto isSignificant = false;
+		auto digitCount = 0;
+
+		for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i, ++digitCount)
+		{
+			if (isSignificant || text[i] != '0')
+			{
+				isSignificant = true;
+				magnitude += 1;
+			}
+		}
+
+		if (i < text.size() && text[i] == '.')
+		{
+			for (i += 1; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i, ++digitCount)
+			{
+				if (!isSignificant)
+				{
+					if (text[i] != '0')
+						isSignificant = true;
+					else
+						magnitude -= 1;
+				}
+			}
+		}
+
+		if (digitCount == 0)
+			return false;
+
+		if (i < text.size() && (text[i] == 'e' || text[i] == 'E'))
+		{
+			i += 1;
+
+			auto isNegative = i < text.size() && text[i] == '-';
+
+			if (i < text.size() && (text[i] == '+' || text[i] == '-'))
+				i += 1;
+
+			if (i == text.size())
+				return false;
+
+			long long exponent = 0;
+
+			for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i)
+			{
+				// Saturates well beyond the range of a double.
+				if (exponent < 1000000)
+					exponent = exponent * 10 + (text[i] - '0');
+			}
+
+			magnitude += isNegative ? -exponent : exponent;
+		}
+
+		return i == text.size() && magnitude <= 0;
+	}
+
+	static std::optional<double> underflow(std::string_view text)
+	{
+		if (!isBelowOne(text))
+			return {};
+
+		return text[0] == '-'
+			? -0.0
+			: 0.0;
+	}
+
+	static std::optional<double> parseDouble(std::string_view text)
+	{
+		auto value = 0.0;
+
+#ifdef __cpp_lib_to_chars
+		const auto* end = text.data() + text.size();
+		auto result = std::from_chars(text.data(), end, value);
+
+		if (result.ec == std::errc::result_out_of_range && result.ptr == end)
+			return underflow(text);
+
+		if (result.ec != std::errc() || result.ptr != end)
+			return {};
+#else
+		// The classic locale keeps '.' as the decimal point regardless of the
+		// global locale.
+		auto stream = std::istringstream(std::string(text));
+
+		stream.imbue(std::locale::classic());
+		stream >> value;
+
+		if (stream.fail())
+			return underflow(text);
+
+		if (stream.peek() != std::char_traits<char>::eof())
+			return {};
+#endif
+
+		return value;
+	}
+
+	std::optional<Value> parseNumber(std::string_view text)
+	{
+		// Rejects the spellings of infinity and NaN that from_chars accepts.
+		if (text.empty() || (text[0] != '-' && (text[0] < '0' || text[0] > '9')))
+			return {};
+
+		if (auto integer = parseInteger(text))
+			return integer;
+
+		auto decimal = parseDouble(text);
+
+		if (!decimal)
+			return {};
+
+		return Value(*decimal);
+	}
+
+	static char* formatInteger(char* out, int64_t value)
+	{
+		return std::to_chars(out, out + maxNumberLength, value).ptr;
+	}
+
+	static char* formatDouble(char* out, double value)
+	{
+#ifdef __cpp_lib_to_chars
+		return std::to_chars(out, out + maxNumberLength, value).ptr;
+#else
+		// Without a shortest round-trip formatter, the precision is raised
+		// until the text parses back to the same number. The classic locale
+		// keeps '.' as the decimal point.
+		auto text = std::string();
+
+		for (auto precision = 15; precision <= 17; ++precision)
+		{
+			auto stream = std::ostringstream();
+
+			stream.imbue(std::locale::classic());
+			stream << std::setprecision(precision) << value;
+			text = stream.str();
+
+			if (parseDouble(text) == value)
+				break;
+		}
+
+		memcpy(out, text.data(), text.length());
+
+		return out + text.length();
+#endif
+	}
+
+	char* formatNumber(char* out, const Value& value)
+	{
+		assert(value.isNumber());
+
+		if (value.isInteger())
+			return formatInteger(out, value.integer());
+
+		auto number = value.number();
+
+		if (!std::isfinite(number))
+		{
+			memcpy(out, "null", 4);
+			return out + 4;
+		}
+
+		// Doubles holding small whole numbers take the integer path, which
+		// is faster and gives the same text. -0 keeps its sign.
+		if (number >= -9007199254740992.0 && number <= 9007199254740992.0 && number == (double)(int64_t)number && !(number == 0.0 && std::signbit(number)))
+			return formatInteger(out, (int64_t)number);
+
+		return formatDouble(out, number);
+	}
+}
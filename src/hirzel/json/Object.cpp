@@ -0,0 +1,205 @@
+#include "hirzel/json/Object.hpp"
+#include "hirzel/json/Value.hpp"
+
+#include <cassert>
+
+namespace hirzel::json
+{
+	Object::Object() = default;
+
+	Object::Object(std::pmr::memory_resource* resource):
+		_members(resource),
+		_index(resource)
+	{}
+
+	Object::Object(Object&& other) noexcept = default;
+
+	Object::Object(const Object& other) = default;
+
+	Object::Object(const Object& other, std::pmr::memory_resource* resource):
+		_members(other._members, resource),
+		_index(other._index, resource)
+	{}
+
+	Object::~Object() = default;
+
+	Object& Object::operator=(Object&& other) = default;
+
+	Object& Object::operator=(const Object& other) = default;
+
+	void Object::reserve(size_t capacity)
+	{
+		_members.reserve(capacity);
+	}
+
+	void Object::clear()
+	{
+		_members.clear();
+		_index.clear();
+	}
+
+	// Interned keys share their data, so a match is usually found by
+	// comparing pointers before the characters are compared.
+	static bool isSameKey(std::string_view a, std::string_view b)
+	{
+		return (a.data() == b.data() && a.length() == b.length()) || a == b;
+	}
+
+	size_t Object::findPosition(std::string_view key) const
+	{
+		return _index.empty()
+			? findLinear(key)
+			: findIndexed(key, hashKey(key));
+	}
+
+	size_t Object::findPosition(const Key& key) const
+	{
+		return _index.empty()
+			? findLinear(key.text())
+			: findIndexed(key.text(), key.hash());
+	}
+
+	size_t Object::findLinear(std::string_view key) const
+	{
+		for (size_t i = 0; i < _members.size(); ++i)
+		{
+			if (isSameKey(_members[i].first.view(), key))
+				return i;
+		}
+
+		return _members.size();
+	}
+
+	size_t Object::findIndexed(std::string_view key, size_t hash) const
+	{
+		auto mask = _index.size() - 1;
+
+		for (auto slot = hash & mask; _index[slot]; slot = (slot + 1) & mask)
+		{
+			auto position = _index[slot] - 1;
+
+			if (isSameKey(_members[position].first.view(), key))
+				return position;
+		}
+
+		return _members.size();
+	}
+
+	// The index is kept at most half full so that probe sequences stay short.
+	void Object::addToIndex(size_t position)
+	{
+		if (_index.empty())
+		{
+			if (_members.size() >= indexThreshold)
+				buildIndex();
+
+			return;
+		}
+
+		if (_members.size() * 2 > _index.size())
+		{
+			buildIndex();
+			return;
+		}
+
+		auto mask = _index.size() - 1;
+		auto slot = hashKey(_members[position].first.view()) & mask;
+
+		while (_index[slot])
+			slot = (slot + 1) & mask;
+
+		_index[slot] = (uint32_t)position + 1;
+	}
+
+	void Object::buildIndex()
+	{
+		assert(_members.size() < UINT32_MAX);
+
+		size_t capacity = indexThreshold * 2;
+
+		while (capacity < _members.size() * 2)
+			capacity *= 2;
+
+		_index.assign(capacity, 0);
+
+		auto mask = capacity - 1;
+
+		for (size_t i = 0; i < _members.size(); ++i)
+		{
+			auto slot = hashKey(_members[i].first.view()) & mask;
+
+			while (_index[slot])
+				slot = (slot + 1) & mask;
+
+			_index[slot] = (uint32_t)i + 1;
+		}
+	}
+
+	Object::iterator Object::find(std::string_view key)
+	{
+		return _members.begin() + findPosition(key);
+	}
+
+	Object::const_iterator Object::find(std::string_view key) const
+	{
+		return _members.begin() + findPosition(key);
+	}
+
+	Object::iterator Object::find(const Key& key)
+	{
+		return _members.begin() + findPosition(key);
+	}
+
+	Object::const_iterator Object::find(const Key& key) const
+	{
+		return _members.begin() + findPosition(key);
+	}
+
+	std::pair<Object::iterator, bool> Object::emplace(String&& key, Value&& value)
+	{
+		auto position = findPosition(key.view());
+
+		if (position != _members.size())
+			return { _members.begin() + position, false };
+
+		_members.emplace_back(std::move(key), std::move(value));
+		addToIndex(position);
+
+		return { _members.begin() + position, true };
+	}
+
+	Value& Object::operator[](std::string_view key)
+	{
+		auto position = findPosition(key);
+
+		if (position != _members.size())
+			return _members[position].second;
+
+		_members.emplace_back(String(key), Value());
+		addToIndex(position);
+
+		return _members[position].second;
+	}
+
+	// Later members move down, so the index is rebuilt.
+	size_t Object::erase(std::string_view key)
+	{
+		auto position = findPosition(key);
+
+		if (position == _members.size())
+			return 0;
+
+		_members.erase(_members.begin() + position);
+
+		if (_members.size() >= indexThreshold)
+		{
+			buildIndex();
+		}
+		else
+		{
+			_index.clear();
+		}
+
+		return 1;
+	}
+}
@@ -0,0 +1,213 @@
+#include "hirzel/json/ParseError.hpp"
+#include "hirzel/json/Error.hpp"
+
+namespace hirzel::json
+{
+	const char* errorCodeName(ErrorCode code)
+	{
+		switch (code)
+		{
+			case ErrorCode::None:
+				return "none";
+
+			case ErrorCode::InvalidCharacter:
+				return "invalid character";
+
+			case ErrorCode::InvalidString:
+				return "invalid string";
+
+			case ErrorCode::UnterminatedString:
+				return "unterminated string";
+
+			case ErrorCode::InvalidNumber:
+				return "invalid number";
+
+			case ErrorCode::InvalidKeyword:
+				return "invalid keyword";
+
+			case ErrorCode::UnexpectedToken:
+				return "unexpected token";
+
+			case ErrorCode::NumberOutOfRange:
+				return "number out of range";
+
+			case ErrorCode::DepthExceeded:
+				return "depth exceeded";
+
+			case ErrorCode::UnbalancedBrackets:
+				return "unbalanced brackets";
+
+			case ErrorCode::UnexpectedEnd:
+				return "unexpected end";
+
+			case ErrorCode::Unindexable:
+				return "unindexable";
+
+			case ErrorCode::InvalidPointer:
+				return "invalid pointer";
+
+			case ErrorCode::FileError:
+				return "file error";
+
+			case ErrorCode::LengthExceeded:
+				return "length exceeded";
+
+			default:
+				break;
+		}
+
+		return "unknown error";
+	}
+
+	ParseError::ParseError(ErrorCode code, const char* src, size_t srcLength, size_t offset, size_t length, const char* detail):
+		_src(src),
+		_srcLength(srcLength),
+		_offset(offset),
+		_length(length),
+		_detail(detail),
+		_code(code)
+	{}
+
+	ParseError::ParseError(ErrorCode code, size_t offset, size_t line, size_t column, const char* detail):
+		_offset(offset),
+		_line(line),
+		_column(column),
+		_detail(detail),
+		_code(code)
+	{}
+
+	void ParseError::detachSource()
+	{
+		_line = line();
+		_column = column();
+		_src = nullptr;
+		_srcLength = 0;
+		_length = 0;
+	}
+
+	size_t ParseError::line() const
+	{
+		if (!_src)
+			return _line;
+
+		size_t line = 1;
+
+		for (size_t i = 0; i < _offset && i < _srcLength; ++i)
+		{
+			if (_src[i] == '\n')
+				line += 1;
+		}
+
+		return line;
+	}
+
+	size_t ParseError::column() const
+	{
+		if (!_src)
+			return _column;
+
+		auto i = _offset < _srcLength
+			? _offset
+			: _srcLength;
+
+		while (i > 0 && _src[i - 1] != '\n')
+			i -= 1;
+
+		return _offset - i + 1;
+	}
+
+	std::string_view ParseError::text() const
+	{
+		if (!_src || _offset >= _srcLength)
+			return {};
+
+		auto length = _length < _srcLength - _offset
+			? _length
+			: _srcLength - _offset;
+
+		return { _src + _offset, length };
+	}
+
+	std::string ParseError::message() const
+	{
+		auto message = std::string();
+
+		switch (_code)
+		{
+			case ErrorCode::FileError:
+				message += "Unable to map file '";
+				message += text();
+				message += "': ";
+				message += _detail;
+				return message;
+
+			case ErrorCode::InvalidPointer:
+				message += "Unable to parse JSON pointer '";
+				message += std::string_view(_src, _srcLength);
+				message += "' at index ";
+				message += std::to_string(_offset);
+				message += ": ";
+				message += _detail;
+				return message;
+
+			default:
+				break;
+		}
+
+		message += "Unable to parse JSON at line ";
+		message += std::to_string(line());
+		message += ", column ";
+		message += std::to_string(column());
+		message += ": ";
+
+		switch (_code)
+		{
+			case ErrorCode::UnexpectedToken:
+				message += "Expected ";
+				message += _detail;
+
+				// The text is not known for streams and detached errors.
+				if (_src)
+				{
+					message += ", but got '";
+					message += text();
+					message += "'";
+				}
+
+				message += ".";
+				break;
+
+			case ErrorCode::NumberOutOfRange:
+				if (!_src)
+				{
+					message += "Number is out of range.";
+					break;
+				}
+
+				message += "Number '";
+				message += text();
+				message += "' is out of range.";
+				break;
+
+			default:
+				message += _detail
+					? _detail
+					: errorCodeName(_code);
+				break;
+		}
+
+		return message;
+	}
+
+	void reportError(ParseError* result, const ParseError& error)
+	{
+		if (result)
+		{
+			*result = error;
+			return;
+		}
+
+		if (hasErrorCallback())
+			pushError(error.message());
+	}
+}
@@ -0,0 +1,160 @@
+#include "hirzel/json/Pointer.hpp"
+
+namespace hirzel::json
+{
+	static void pointerError(ParseError* error, std::string_view text, size_t offset, const char* message)
+	{
+		reportError(error, ParseError(ErrorCode::InvalidPointer, text.data(), text.length(), offset, 1, message));
+	}
+
+	// Array indices are "0" or digits without a leading zero.
+	static size_t parseIndex(std::string_view token, size_t noIndex)
+	{
+		if (token.empty() || token.length() > 19 || (token[0] == '0' && token.length() > 1))
+			return noIndex;
+
+		size_t index = 0;
+
+		for (auto c : token)
+		{
+			if (c < '0' || c > '9')
+				return noIndex;
+
+			index = index * 10 + (size_t)(c - '0');
+		}
+
+		return index;
+	}
+
+	std::optional<Pointer> Pointer::parse(std::string_view text, ParseError* error)
+	{
+		auto pointer = Pointer();
+
+		if (text.empty())
+			return pointer;
+
+		if (text[0] != '/')
+		{
+			pointerError(error, text, 0, "Expected '/'.");
+			return {};
+		}
+
+		pointer._names.reserve(text.length());
+
+		size_t i = 1;
+
+		while (true)
+		{
+			auto offset = pointer._names.length();
+
+			while (i < text.length() && text[i] != '/')
+			{
+				auto c = text[i];
+
+				i += 1;
+
+				if (c != '~')
+				{
+					pointer._names += c;
+					continue;
+				}
+
+				if (i == text.length() || (text[i] != '0' && text[i] != '1'))
+				{
+					pointerError(error, text, i - 1, "Expected '0' or '1' after '~'.");
+					return {};
+				}
+
+				pointer._names += text[i] == '0'
+					? '~'
+					: '/';
+				i += 1;
+			}
+
+			auto name = std::string_view(pointer._names).substr(offset);
+			auto segment = Segment();
+
+			segment.offset = offset;
+			segment.length = name.length();
+			segment.hash = hashKey(name);
+			segment.index = parseIndex(name, noIndex);
+
+			pointer._segments.push_back(segment);
+
+			if (i == text.length())
+				break;
+
+			// Skips the '/' that starts the next token.
+			i += 1;
+		}
+
+		return pointer;
+	}
+
+	std::string_view Pointer::token(size_t i) const
+	{
+		const auto& segment = _segments[i];
+
+		return std::string_view(_names).substr(segment.offset, segment.length);
+	}
+
+	// Resolving a const value only reads it, while resolving a mutable one
+	// clones the shared containers along the path.
+	template <typename V>
+	V* Pointer::resolveValue(V& root) const
+	{
+		auto* value = &root;
+
+		for (size_t i = 0; i < _segments.size() && value; ++i)
+		{
+			const auto& segment = _segments[i];
+
+			switch (value->type())
+			{
+				case ValueType::Object:
+					value = value->at(Key(token(i), segment.hash));
+					break;
+
+				case ValueType::Array:
+					value = segment.index != noIndex
+						? value->at(segment.index)
+						: nullptr;
+					break;
+
+				default:
+					value = nullptr;
+					break;
+			}
+		}
+
+		return value;
+	}
+
+	const Value* Pointer::resolve(const Value& root) const
+	{
+		return resolveValue(root);
+	}
+
+	Value* Pointer::resolve(Value& root) const
+	{
+		return resolveValue(root);
+	}
+
+	const Value* resolve(const Value& root, std::string_view pointer)
+	{
+		auto parsed = Pointer::parse(pointer);
+
+		return parsed
+			? parsed->resolve(root)
+			: nullptr;
+	}
+
+	Value* resolve(Value& root, std::string_view pointer)
+	{
+		auto parsed = Pointer::parse(pointer);
+
+		return parsed
+			? parsed->resolve(root)
+			: nullptr;
+	}
+}
@@ -0,0 +1,331 @@
+#include "hirzel/json/Reader.hpp"
+#include "hirzel/json/Escape.hpp"
+#include "hirzel/json/Number.hpp"
+
+#include <cstring>
+
+namespace hirzel::json
+{
+	Reader::Reader(const char* json, ParseError* error):
+		Reader(json, strlen(json), error)
+	{}
+
+	Reader::Reader(const char* json, size_t length, ParseError* error):
+		_token(Token::parse(json, length, error)),
+		_isObjectStack(),
+		_scratch(),
+		_error(error),
+		_state(_token ? State::Value : State::Failed)
+	{}
+
+	bool Reader::advance()
+	{
+		_token = _token->parseNext(_error);
+
+		if (!_token)
+		{
+			_state = State::Failed;
+			return false;
+		}
+
+		return true;
+	}
+
+	// Text between a string's quotes, with its escape sequences decoded into
+	// the scratch buffer if it has any.
+	std::optional<std::string_view> Reader::decode(const Token& token)
+	{
+		auto text = token.view().substr(1, token.length() - 2);
+
+		if (!memchr(text.data(), '\\', text.length()))
+			return text;
+
+		if (_scratch.size() < text.length())
+			_scratch.resize(text.length());
+
+		size_t errorOffset = 0;
+		auto length = unescape(text, _scratch.data(), errorOffset);
+
+		if (!length)
+		{
+			_state = State::Failed;
+			reportError(_error, ParseError(ErrorCode::InvalidString, token.src(), token.srcLength(), token.index() + 1 + errorOffset, 2, "Invalid escape sequence."));
+			return {};
+		}
+
+		return std::string_view(_scratch.data(), *length);
+	}
+
+	std::optional<Event> Reader::fail(const char* expected)
+	{
+		const auto& token = *_token;
+
+		_state = State::Failed;
+		reportError(_error, ParseError(ErrorCode::UnexpectedToken, token.src(), token.srcLength(), token.index(), token.length(), expected));
+
+		return {};
+	}
+
+	std::optional<Event> Reader::readValue()
+	{
+		const auto& token = *_token;
+		auto text = token.view();
+
+		switch (token.type())
+		{
+			case TokenType::LeftBrace:
+				_isObjectStack.push_back(true);
+				_state = State::ObjectStart;
+
+				if (!advance())
+					return {};
+
+				return Event(EventType::StartObject);
+
+			case TokenType::LeftBracket:
+				_isObjectStack.push_back(false);
+				_state = State::ArrayStart;
+
+				if (!advance())
+					return {};
+
+				return Event(EventType::StartArray);
+
+			case TokenType::String:
+			{
+				auto string = decode(token);
+
+				if (!string)
+					return {};
+
+				_state = State::AfterValue;
+
+				if (!advance())
+					return {};
+
+				return Event(EventType::String, *string);
+			}
+
+			case TokenType::Number:
+			{
+				auto number = parseNumber(text);
+
+				if (!number)
+				{
+					_state = State::Failed;
+					reportError(_error, ParseError(ErrorCode::NumberOutOfRange, token.src(), token.srcLength(), token.index(), token.length(), nullptr));
+					return {};
+				}
+
+				_state = State::AfterValue;
+
+				if (!advance())
+					return {};
+
+				return Event(EventType::Number, text, std::move(*number));
+			}
+
+			case TokenType::True:
+			case TokenType::False:
+			{
+				auto value = token.type() == TokenType::True;
+
+				_state = State::AfterValue;
+
+				if (!advance())
+					return {};
+
+				return Event(EventType::Boolean, text, Value(value));
+			}
+
+			case TokenType::Null:
+				_state = State::AfterValue;
+
+				if (!advance())
+					return {};
+
+				return Event(EventType::Null, text);
+
+			default:
+				break;
+		}
+
+		return fail("object, array, string, number, boolean, or null");
+	}
+
+	std::optional<Event> Reader::readKey()
+	{
+		const auto& token = *_token;
+
+		if (token.type() != TokenType::String)
+			return fail("label");
+
+		auto text = decode(token);
+
+		if (!text || !advance())
+			return {};
+
+		if (_token->type() != TokenType::Colon)
+			return fail("':'");
+
+		if (!advance())
+			return {};
+
+		_state = State::Value;
+
+		return Event(EventType::Key, *text);
+	}
+
+	std::optional<Event> Reader::readAfterValue()
+	{
+		auto type = _token->type();
+
+		if (_isObjectStack.empty())
+		{
+			if (type != TokenType::EndOfFile)
+				return fail("end of file");
+
+			_state = State::Done;
+
+			return Event(EventType::EndOfFile);
+		}
+
+		auto isObject = _isObjectStack.back();
+
+		if (type == TokenType::Comma)
+		{
+			if (!advance())
+				return {};
+
+			_state = isObject
+				? State::Key
+				: State::Value;
+
+			return isObject
+				? readKey()
+				: readValue();
+		}
+
+		if (isObject && type != TokenType::RightBrace)
+			return fail("'}'");
+
+		if (!isObject && type != TokenType::RightBracket)
+			return fail("']'");
+
+		_isObjectStack.pop_back();
+
+		if (!advance())
+			return {};
+
+		return Event(isObject ? EventType::EndObject : EventType::EndArray);
+	}
+
+	std::optional<Event> Reader::next()
+	{
+		switch (_state)
+		{
+			case State::Value:
+				return readValue();
+
+			case State::ObjectStart:
+				if (_token->type() != TokenType::RightBrace)
+					return readKey();
+
+				_isObjectStack.pop_back();
+				_state = State::AfterValue;
+
+				if (!advance())
+					return {};
+
+				return Event(EventType::EndObject);
+
+			case State::ArrayStart:
+				if (_token->type() != TokenType::RightBracket)
+					return readValue();
+
+				_isObjectStack.pop_back();
+				_state = State::AfterValue;
+
+				if (!advance())
+					return {};
+
+				return Event(EventType::EndArray);
+
+			case State::Key:
+				return readKey();
+
+			case State::AfterValue:
+				return readAfterValue();
+
+			case State::Done:
+				return Event(EventType::EndOfFile);
+
+			default:
+				break;
+		}
+
+		return {};
+	}
+
+	static bool dispatch(const Event& event, Handler& handler)
+	{
+		switch (event.type())
+		{
+			case EventType::StartObject:
+				return handler.startObject();
+
+			case EventType::EndObject:
+				return handler.endObject();
+
+			case EventType::StartArray:
+				return handler.startArray();
+
+			case EventType::EndArray:
+				return handler.endArray();
+
+			case EventType::Key:
+				return handler.key(event.text());
+
+			case EventType::String:
+				return handler.string(event.text());
+
+			case EventType::Number:
+				return handler.number(event.value());
+
+			case EventType::Boolean:
+				return handler.boolean(event.boolean());
+
+			case EventType::Null:
+				return handler.null();
+
+			default:
+				break;
+		}
+
+		return true;
+	}
+
+	bool read(const char* json, Handler& handler, ParseError* error)
+	{
+		return read(json, strlen(json), handler, error);
+	}
+
+	bool read(const char* json, size_t length, Handler& handler, ParseError* error)
+	{
+		auto reader = Reader(json, length, error);
+
+		while (true)
+		{
+			auto event = reader.next();
+
+			if (!event)
+				return false;
+
+			if (event->type() == EventType::EndOfFile)
+				return true;
+
+			if (!dispatch(*event, handler))
+				return false;
+		}
+	}
+}
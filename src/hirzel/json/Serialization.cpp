@@ -1,55 +1,158 @@
 #include "hirzel/json/Serialization.hpp"
 #include "hirzel/json/Error.hpp"
+#include "hirzel/json/Escape.hpp"
+#include "hirzel/json/Number.hpp"
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 namespace hirzel::json
 {
-	std::string serializeNull(const Value& value);
-	std::string serializeNumber(const Value& value);
-	std::string serializeBoolean(const Value& value);
-	std::string serializeString(const Value& value);
-	std::string serializeArray(const Value& value);
-	std::string serializeObject(const Value& value);
+	void serializeValue(const Value& value, Writer& writer, const SerializationOptions& options);
+	void serializeText(std::string_view text, Writer& writer);
+	void serializeNull(const Value& value, Writer& writer);
+	void serializeNumber(const Value& value, Writer& writer);
+	void serializeBoolean(const Value& value, Writer& writer);
+	void serializeString(const Value& value, Writer& writer);
+	void serializeArray(const Value& value, Writer& writer, const SerializationOptions& options);
+	void serializeObject(const Value& value, Writer& writer, const SerializationOptions& options);
 
 	std::string serialize(const Value& value)
+	{
+		return serialize(value, SerializationOptions());
+	}
+
+	std::string serialize(const Value& value, const SerializationOptions& options)
+	{
+		auto writer = StringWriter();
+
+		serializeValue(value, writer, options);
+
+		return writer.release();
+	}
+
+	bool serialize(const Value& value, Writer& writer)
+	{
+		return serialize(value, writer, SerializationOptions());
+	}
+
+	bool serialize(const Value& value, Writer& writer, const SerializationOptions& options)
+	{
+		serializeValue(value, writer, options);
+
+		return writer.flush();
+	}
+
+	static bool isParallel(size_t length, const SerializationOptions& options)
+	{
+		return options.minParallelLength > 0 && length >= options.minParallelLength;
+	}
+
+	// Serializes ranges of the items into separate buffers on the pool and
+	// writes the buffers in order. Children of the items are serialized
+	// serially so that the pool is not oversubscribed.
+	template <typename Item, typename SerializeItem>
+	static void serializeItemsParallel(const std::vector<Item>& items, Writer& writer, const SerializationOptions& options, SerializeItem serializeItem)
+	{
+		auto& pool = options.pool
+			? *options.pool
+			: ThreadPool::shared();
+		auto itemCount = items.size();
+		// Several chunks per thread even out items of different sizes.
+		auto chunkCount = std::min(itemCount, (pool.threadCount() + 1) * 4);
+		auto chunks = std::vector<std::string>(chunkCount);
+		auto serialOptions = options;
+
+		serialOptions.minParallelLength = 0;
+
+		pool.parallelFor(chunkCount, [&](size_t chunkIndex)
+		{
+			auto begin = itemCount * chunkIndex / chunkCount;
+			auto end = itemCount * (chunkIndex + 1) / chunkCount;
+			auto chunkWriter = StringWriter();
+
+			for (auto i = begin; i < end; ++i)
+			{
+				if (i > begin)
+					chunkWriter.write(',');
+
+				serializeItem(items[i], chunkWriter, serialOptions);
+			}
+
+			chunks[chunkIndex] = chunkWriter.release();
+		});
+
+		for (size_t i = 0; i < chunkCount; ++i)
+		{
+			if (i > 0)
+				writer.write(',');
+
+			writer.write(chunks[i]);
+		}
+	}
+
+	void serializeValue(const Value& value, Writer& writer, const SerializationOptions& options)
 	{
 		switch (value.type())
 		{
 			case ValueType::Null:
-				return serializeNull(value);
+				serializeNull(value, writer);
+				break;
 
 			case ValueType::Number:
-				return serializeNumber(value);
+				serializeNumber(value, writer);
+				break;
 
 			case ValueType::Boolean:
-				return serializeBoolean(value);
+				serializeBoolean(value, writer);
+				break;
 
 			case ValueType::String:
-				return serializeString(value);
+				serializeString(value, writer);
+				break;
 
 			case ValueType::Array:
-				return serializeArray(value);
+				serializeArray(value, writer, options);
+				break;
 
 			case ValueType::Object:
-				return serializeObject(value);
-			
+				serializeObject(value, writer, options);
+				break;
+
 			default:
 				break;
 		}
-
-		return "";
 	}
 
-	std::string serializeObject(const Value& value)
+	void serializeObject(const Value& value, Writer& writer, const SerializationOptions& options)
 	{
 		assert(value.isObject());
 
 		const auto& object = value.object();
 
-		auto text = std::string();
+		writer.write('{');
 
-		text += '{';
+		if (isParallel(object.size(), options))
+		{
+			auto pairs = std::vector<const Object::value_type*>();
+
+			pairs.reserve(object.size());
+
+			for (const auto& pair : object)
+				pairs.push_back(&pair);
+
+			serializeItemsParallel(pairs, writer, options, [](const Object::value_type* pair, Writer& writer, const SerializationOptions& options)
+			{
+				serializeText(pair->first.view(), writer);
+				writer.write(':');
+
+				serializeValue(pair->second, writer, options);
+			});
+
+			writer.write('}');
+			return;
+		}
 
 		auto isFirst = true;
 
@@ -61,92 +164,164 @@ namespace hirzel::json
 			}
 			else
 			{
-				text += ',';
+				writer.write(',');
 			}
 
-			text += '\"';
-			text += pair.first;
-			text += "\":";
+			serializeText(pair.first.view(), writer);
+			writer.write(':');
 
-			auto itemText = serialize(pair.second);
-
-			text += itemText;
+			serializeValue(pair.second, writer, options);
 		}
 
-		text += '}';
-
-		return text;
+		writer.write('}');
 	}
 
-	std::string serializeArray(const Value& value)
+	void serializeArray(const Value& value, Writer& writer, const SerializationOptions& options)
 	{
 		assert(value.isArray());
 
 		const auto& array = value.array();
-		auto text = std::string();
 
-		text += '[';
+		writer.write('[');
+
+		if (isParallel(array.size(), options))
+		{
+			auto items = std::vector<const Value*>();
+
+			items.reserve(array.size());
+
+			for (const auto& item : array)
+				items.push_back(&item);
+
+			serializeItemsParallel(items, writer, options, [](const Value* item, Writer& writer, const SerializationOptions& options)
+			{
+				serializeValue(*item, writer, options);
+			});
+
+			writer.write(']');
+			return;
+		}
 
 		for (size_t i = 0; i < array.size(); ++i)
 		{
 			if (i > 0)
 			{
-				text += ',';
+				writer.write(',');
 			}
 
-			const auto& item = array[i];
-			auto itemText = serialize(item);
-
-			text += itemText;
+			serializeValue(array[i], writer, options);
 		}
 
-		text += ']';
-
-		return text;
+		writer.write(']');
 	}
 
-	std::string serializeString(const Value& value)
+	void serializeString(const Value& value, Writer& writer)
 	{
 		assert(value.isString());
-		
-		// TODO: Escaping text
-		auto text = std::string();
-		auto valueText = value.string();
 
-		text.reserve(valueText.length() + 2);
+		serializeText(value.string(), writer);
+	}
+
+	// Writes a string with quotes and escape sequences. Runs of characters
+	// that need no escaping are found a vector at a time and written whole.
+	void serializeText(std::string_view text, Writer& writer)
+	{
+		static const char* hexDigits = "0123456789abcdef";
+		size_t start = 0;
+
+		writer.write('\"');
+
+		while (true)
+		{
+			auto end = findEscapable(text, start);
+
+			writer.write(text.data() + start, end - start);
 
-		text += '\"';
-		text += valueText;
-		text += '\"';
+			if (end == text.length())
+				break;
+
+			auto c = (unsigned char)text[end];
+
+			switch (c)
+			{
+				case '\"':
+					writer.write("\\\"", 2);
+					break;
+
+				case '\\':
+					writer.write("\\\\", 2);
+					break;
+
+				case '\b':
+					writer.write("\\b", 2);
+					break;
+
+				case '\f':
+					writer.write("\\f", 2);
+					break;
+
+				case '\n':
+					writer.write("\\n", 2);
+					break;
+
+				case '\r':
+					writer.write("\\r", 2);
+					break;
+
+				case '\t':
+					writer.write("\\t", 2);
+					break;
+
+				default:
+				{
+					char escape[] = { '\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xF] };
 
-		return text;
+					writer.write(escape, sizeof(escape));
+					break;
+				}
+			}
+
+			start = end + 1;
+		}
+
+		writer.write('\"');
 	}
 
-	std::string serializeNumber(const Value& value)
+	void serializeNumber(const Value& value, Writer& writer)
 	{
 		assert(value.isNumber());
 
-		auto number = value.number();
-		auto text = std::to_string(number);
+		// The number is formatted in place unless the buffer is too small.
+		if (auto* out = writer.reserve(maxNumberLength))
+		{
+			writer.commit(formatNumber(out, value));
+			return;
+		}
 
-		return text;
+		char buffer[maxNumberLength];
+		auto* end = formatNumber(buffer, value);
+
+		writer.write(buffer, end - buffer);
 	}
 
-	std::string serializeBoolean(const Value& value)
+	void serializeBoolean(const Value& value, Writer& writer)
 	{
 		assert(value.isBoolean());
-		
-		const auto* text = value.boolean()
-			? "true"
-			: "false";
 
-		return text;
+		if (value.boolean())
+		{
+			writer.write("true", 4);
+		}
+		else
+		{
+			writer.write("false", 5);
+		}
 	}
 
-	std::string serializeNull(const Value& value)
+	void serializeNull(const Value& value, Writer& writer)
 	{
 		assert(value.isNull());
 
-		return "null";
+		writer.write("null", 4);
 	}
 }
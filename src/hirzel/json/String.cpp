@@ -0,0 +1,127 @@
+#include "hirzel/json/String.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace hirzel::json
+{
+	static const char* const emptyText = "";
+
+	static const char* copyText(std::string_view text)
+	{
+		auto* data = new char[text.length()];
+
+		memcpy(data, text.data(), text.length());
+
+		return data;
+	}
+
+	String::String():
+		_data(emptyText),
+		_length(0),
+		_isOwned(false)
+	{}
+
+	String::String(std::string_view text):
+		_data(emptyText),
+		_length((uint32_t)text.length()),
+		_isOwned(false)
+	{
+		assert(text.length() <= UINT32_MAX);
+
+		if (text.empty())
+			return;
+
+		_data = copyText(text);
+		_isOwned = true;
+	}
+
+	String::String(const std::string& text):
+		String(std::string_view(text))
+	{}
+
+	String::String(const char* text):
+		String(std::string_view(text))
+	{}
+
+	String::String(std::string_view text, Arena& arena):
+		_data(emptyText),
+		_length((uint32_t)text.length()),
+		_isOwned(false)
+	{
+		assert(text.length() <= UINT32_MAX);
+
+		if (text.empty())
+			return;
+
+		auto* data = (char*)arena.allocate(text.length(), 1);
+
+		memcpy(data, text.data(), text.length());
+
+		_data = data;
+	}
+
+	String::String(String&& other) noexcept:
+		_data(other._data),
+		_length(other._length),
+		_isOwned(other._isOwned)
+	{
+		other._data = emptyText;
+		other._length = 0;
+		other._isOwned = false;
+	}
+
+	String::String(const String& other):
+		String(other.view())
+	{}
+
+	String::~String()
+	{
+		if (_isOwned)
+			delete[] _data;
+	}
+
+	String String::borrow(std::string_view text)
+	{
+		assert(text.length() <= UINT32_MAX);
+
+		auto string = String();
+
+		if (!text.empty())
+		{
+			string._data = text.data();
+			string._length = (uint32_t)text.length();
+		}
+
+		return string;
+	}
+
+	String& String::operator=(String&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		this->~String();
+		new (this) auto(std::move(other));
+
+		return *this;
+	}
+
+	String& String::operator=(const String& other)
+	{
+		if (this == &other)
+			return *this;
+
+		auto copy = String(other);
+
+		return *this = std::move(copy);
+	}
+
+	std::ostream& operator<<(std::ostream& out, const String& string)
+	{
+		out << string.view();
+
+		return out;
+	}
+}
@@ -0,0 +1,332 @@
+#include "hirzel/json/StructuralIndex.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HIRZEL_JSON_X86
+#include <immintrin.h>
+#endif
+
+namespace hirzel::json
+{
+	struct BlockMasks
+	{
+		uint64_t quote;
+		uint64_t backslash;
+		uint64_t whitespace;
+		uint64_t structural;
+		uint64_t slash;
+	};
+
+	using ClassifyFunction = void (*)(const unsigned char* block, BlockMasks& masks);
+
+	static const size_t blockSize = 64;
+
+	static void classifyScalar(const unsigned char* block, BlockMasks& masks)
+	{
+		masks = BlockMasks();
+
+		for (size_t i = 0; i < blockSize; ++i)
+		{
+			auto c = block[i];
+			auto bit = 1ULL << i;
+
+			switch (c)
+			{
+				case '\"':
+					masks.quote |= bit;
+					break;
+
+				case '\\':
+					masks.backslash |= bit;
+					break;
+
+				case '/':
+					masks.slash |= bit;
+					break;
+
+				case '{':
+				case '}':
+				case '[':
+				case ']':
+				case ':':
+				case ',':
+					masks.structural |= bit;
+					break;
+
+				default:
+					if (c <= ' ' && c != '\0')
+						masks.whitespace |= bit;
+					break;
+			}
+		}
+	}
+
+#ifdef HIRZEL_JSON_X86
+
+	// '[' and ']' differ from '{' and '}' only in bit 5, so setting that bit
+	// lets two comparisons find all four brackets. NUL is not whitespace so
+	// that one inside the text is reported as an invalid token.
+
+	__attribute__((target("sse4.2")))
+	static void classifySse42(const unsigned char* block, BlockMasks& masks)
+	{
+		const auto quote = _mm_set1_epi8('\"');
+		const auto backslash = _mm_set1_epi8('\\');
+		const auto slash = _mm_set1_epi8('/');
+		const auto space = _mm_set1_epi8(' ');
+		const auto zero = _mm_setzero_si128();
+		const auto bracketBit = _mm_set1_epi8(0x20);
+		const auto leftBrace = _mm_set1_epi8('{');
+		const auto rightBrace = _mm_set1_epi8('}');
+		const auto colon = _mm_set1_epi8(':');
+		const auto comma = _mm_set1_epi8(',');
+
+		masks = BlockMasks();
+
+		for (size_t i = 0; i < blockSize; i += 16)
+		{
+			auto chunk = _mm_loadu_si128((const __m128i*)(block + i));
+			auto folded = _mm_or_si128(chunk, bracketBit);
+			auto structural = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(folded, leftBrace), _mm_cmpeq_epi8(folded, rightBrace)),
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, colon), _mm_cmpeq_epi8(chunk, comma)));
+			auto whitespace = _mm_andnot_si128(_mm_cmpeq_epi8(chunk, zero), _mm_cmpeq_epi8(_mm_min_epu8(chunk, space), chunk));
+
+			masks.quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)) << i;
+			masks.backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)) << i;
+			masks.slash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, slash)) << i;
+			masks.structural |= (uint64_t)(uint16_t)_mm_movemask_epi8(structural) << i;
+			masks.whitespace |= (uint64_t)(uint16_t)_mm_movemask_epi8(whitespace) << i;
+		}
+	}
+
+	__attribute__((target("avx2")))
+	static void classifyAvx2(const unsigned char* block, BlockMasks& masks)
+	{
+		const auto quote = _mm256_set1_epi8('\"');
+		const auto backslash = _mm256_set1_epi8('\\');
+		const auto slash = _mm256_set1_epi8('/');
+		const auto space = _mm256_set1_epi8(' ');
+		const auto zero = _mm256_setzero_si256();
+		const auto bracketBit = _mm256_set1_epi8(0x20);
+		const auto leftBrace = _mm256_set1_epi8('{');
+		const auto rightBrace = _mm256_set1_epi8('}');
+		const auto colon = _mm256_set1_epi8(':');
+		const auto comma = _mm256_set1_epi8(',');
+
+		masks = BlockMasks();
+
+		for (size_t i = 0; i < blockSize; i += 32)
+		{
+			auto chunk = _mm256_loadu_si256((const __m256i*)(block + i));
+			auto folded = _mm256_or_si256(chunk, bracketBit);
+			auto structural = _mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(folded, leftBrace), _mm256_cmpeq_epi8(folded, rightBrace)),
+				_mm256_or_si256(_mm256_cmpeq_epi8(chunk, colon), _mm256_cmpeq_epi8(chunk, comma)));
+			auto whitespace = _mm256_andnot_si256(_mm256_cmpeq_epi8(chunk, zero), _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, space), chunk));
+
+			masks.quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, quote)) << i;
+			masks.backslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, backslash)) << i;
+			masks.slash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, slash)) << i;
+			masks.structural |= (uint64_t)(uint32_t)_mm256_movemask_epi8(structural) << i;
+			masks.whitespace |= (uint64_t)(uint32_t)_mm256_movemask_epi8(whitespace) << i;
+		}
+	}
+
+#endif
+
+	bool isScannerSupported(ScannerType scannerType)
+	{
+		switch (scannerType)
+		{
+			case ScannerType::Scalar:
+				return true;
+
+#ifdef HIRZEL_JSON_X86
+			case ScannerType::Sse42:
+				return __builtin_cpu_supports("sse4.2");
+
+			case ScannerType::Avx2:
+				return __builtin_cpu_supports("avx2");
+#endif
+
+			default:
+				break;
+		}
+
+		return false;
+	}
+
+	ScannerType bestScannerType()
+	{
+		static const auto scannerType = isScannerSupported(ScannerType::Avx2)
+			? ScannerType::Avx2
+			: isScannerSupported(ScannerType::Sse42)
+				? ScannerType::Sse42
+				: ScannerType::Scalar;
+
+		return scannerType;
+	}
+
+	const char* scannerTypeName(ScannerType scannerType)
+	{
+		switch (scannerType)
+		{
+			case ScannerType::Scalar:
+				return "scalar";
+
+			case ScannerType::Sse42:
+				return "sse4.2";
+
+			case ScannerType::Avx2:
+				return "avx2";
+
+			default:
+				break;
+		}
+
+		return "invalid scanner";
+	}
+
+	static ClassifyFunction classifyFunction(ScannerType scannerType)
+	{
+		switch (scannerType)
+		{
+#ifdef HIRZEL_JSON_X86
+			case ScannerType::Sse42:
+				return classifySse42;
+
+			case ScannerType::Avx2:
+				return classifyAvx2;
+#endif
+
+			default:
+				break;
+		}
+
+		return classifyScalar;
+	}
+
+	// Marks the characters that follow an unescaped backslash. Backslashes
+	// are rare, so they are visited one at a time.
+	static uint64_t findEscaped(uint64_t backslash, bool& isNextEscaped)
+	{
+		auto escaped = isNextEscaped ? 1ULL : 0ULL;
+
+		isNextEscaped = false;
+		backslash &= ~escaped;
+
+		while (backslash)
+		{
+			auto i = __builtin_ctzll(backslash);
+			auto bit = 1ULL << i;
+
+			backslash &= backslash - 1;
+
+			if (escaped & bit)
+				continue;
+
+			if (i == 63)
+			{
+				isNextEscaped = true;
+			}
+			else
+			{
+				escaped |= bit << 1;
+			}
+		}
+
+		return escaped;
+	}
+
+	// Each bit of the result is set if an odd number of bits at or below it
+	// are set in the input.
+	static uint64_t prefixXor(uint64_t bits)
+	{
+		bits ^= bits << 1;
+		bits ^= bits << 2;
+		bits ^= bits << 4;
+		bits ^= bits << 8;
+		bits ^= bits << 16;
+		bits ^= bits << 32;
+
+		return bits;
+	}
+
+	std::optional<StructuralIndex> StructuralIndex::build(const char* src, size_t length)
+	{
+		return build(src, length, bestScannerType());
+	}
+
+	std::optional<StructuralIndex> StructuralIndex::build(const char* src, size_t length, ScannerType scannerType)
+	{
+		if (length > UINT32_MAX || !isScannerSupported(scannerType))
+			return {};
+
+		auto classify = classifyFunction(scannerType);
+		auto index = StructuralIndex();
+		auto& positions = index._positions;
+		auto isNextEscaped = false;
+		auto inStringCarry = 0ULL;
+		auto scalarCarry = 0ULL;
+		auto masks = BlockMasks();
+		unsigned char padded[blockSize];
+
+		positions.reserve(length / 8 + blockSize);
+
+		for (size_t offset = 0; offset < length; offset += blockSize)
+		{
+			const auto* block = (const unsigned char*)src + offset;
+
+			if (length - offset < blockSize)
+			{
+				memset(padded, ' ', blockSize);
+				memcpy(padded, block, length - offset);
+				block = padded;
+			}
+
+			classify(block, masks);
+
+			auto escaped = masks.backslash || isNextEscaped
+				? findEscaped(masks.backslash, isNextEscaped)
+				: 0;
+			auto quote = masks.quote & ~escaped;
+			auto inString = prefixXor(quote) ^ inStringCarry;
+
+			inStringCarry = 0ULL - (inString >> 63);
+
+			if (masks.slash & ~inString)
+				return {};
+
+			auto structural = masks.structural & ~inString;
+			auto scalar = ~(masks.whitespace | masks.structural | masks.quote | inString);
+			auto scalarStart = scalar & ~((scalar << 1) | scalarCarry);
+
+			scalarCarry = scalar >> 63;
+
+			auto tokens = structural | quote | scalarStart;
+
+			if (!tokens)
+				continue;
+
+			auto count = (size_t)__builtin_popcountll(tokens);
+			auto start = positions.size();
+
+			positions.resize(start + count);
+
+			auto* out = positions.data() + start;
+
+			while (tokens)
+			{
+				*out++ = (uint32_t)(offset + __builtin_ctzll(tokens));
+				tokens &= tokens - 1;
+			}
+		}
+
+		if (inStringCarry)
+			return {};
+
+		return index;
+	}
+}
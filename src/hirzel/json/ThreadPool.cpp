@@ -0,0 +1,137 @@
+#include "hirzel/json/ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace hirzel::json
+{
+	ThreadPool::ThreadPool(size_t threadCount):
+		_threads(),
+		_tasks(),
+		_mutex(),
+		_condition(),
+		_isStopping(false)
+	{
+		if (threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+		_threads.reserve(threadCount);
+
+		for (size_t i = 0; i < threadCount; ++i)
+			_threads.emplace_back([this]() { work(); });
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			auto lock = std::lock_guard<std::mutex>(_mutex);
+
+			_isStopping = true;
+		}
+
+		_condition.notify_all();
+
+		for (auto& thread : _threads)
+			thread.join();
+	}
+
+	void ThreadPool::work()
+	{
+		while (true)
+		{
+			auto task = std::function<void()>();
+
+			{
+				auto lock = std::unique_lock<std::mutex>(_mutex);
+
+				_condition.wait(lock, [this]() { return _isStopping || !_tasks.empty(); });
+
+				if (_tasks.empty())
+					return;
+
+				task = std::move(_tasks.front());
+				_tasks.pop_front();
+			}
+
+			task();
+		}
+	}
+
+	void ThreadPool::submit(std::function<void()>&& task)
+	{
+		{
+			auto lock = std::lock_guard<std::mutex>(_mutex);
+
+			_tasks.push_back(std::move(task));
+		}
+
+		_condition.notify_one();
+	}
+
+	struct ParallelForState
+	{
+		std::atomic<size_t> nextIndex { 0 };
+		std::mutex mutex;
+		std::condition_variable condition;
+		size_t completedCount = 0;
+	};
+
+	static void runParallelFor(ParallelForState& state, size_t count, const std::function<void(size_t i)>& task)
+	{
+		size_t completedCount = 0;
+
+		while (true)
+		{
+			auto i = state.nextIndex.fetch_add(1);
+
+			if (i >= count)
+				break;
+
+			task(i);
+			completedCount += 1;
+		}
+
+		if (completedCount == 0)
+			return;
+
+		auto lock = std::lock_guard<std::mutex>(state.mutex);
+
+		state.completedCount += completedCount;
+
+		if (state.completedCount == count)
+			state.condition.notify_all();
+	}
+
+	void ThreadPool::parallelFor(size_t count, const std::function<void(size_t i)>& task)
+	{
+		if (count == 0)
+			return;
+
+		// Helpers that start after all indices are claimed only touch the
+		// shared state, which they keep alive, and never the task.
+		auto state = std::make_shared<ParallelForState>();
+		auto helperCount = std::min(count - 1, threadCount());
+
+		for (size_t i = 0; i < helperCount; ++i)
+		{
+			submit([state, count, &task]()
+			{
+				runParallelFor(*state, count, task);
+			});
+		}
+
+		runParallelFor(*state, count, task);
+
+		auto lock = std::unique_lock<std::mutex>(state->mutex);
+
+		state->condition.wait(lock, [&]() { return state->completedCount == count; });
+	}
+
+	ThreadPool& ThreadPool::shared()
+	{
+		static auto pool = ThreadPool();
+
+		return pool;
+	}
+}
@@ -1,6 +1,6 @@
 #include "hirzel/json/Token.hpp"
 #include "hirzel/json/TokenType.hpp"
-#include "hirzel/json/Error.hpp"
+#include "hirzel/json/ParseError.hpp"
 
 #include <cstring>
 #include <string>
@@ -8,35 +8,24 @@
 
 namespace hirzel::json
 {
-	static void parseError(const char *subject, const size_t index, const char *message)
+	static void parseError(ParseError* error, ErrorCode code, const char* src, size_t srcLength, size_t index, size_t length, const char* message)
 	{
-		if (!hasErrorCallback())
-			return;
-
-		auto error = std::string();
-
-		error += "Unable to parse ";
-		error += subject;
-		error += " at index ";
-		error += std::to_string(index);
-		error += ": ";
-		error += message;
-
-		pushError(error);
+		reportError(error, ParseError(code, src, srcLength, index, length, message));
 	}
 
-	Token::Token(const char* src, size_t index, size_t length, TokenType type):
+	Token::Token(const char* src, size_t srcLength, size_t index, size_t length, TokenType type):
 		_src(src),
+		_srcLength(srcLength),
 		_index(index),
 		_length(length),
 		_type(type)
 	{}
 
-	static size_t getEndOfLineCommentIndex(const char* src, size_t index)
+	static size_t getEndOfLineCommentIndex(const char* src, size_t srcLength, size_t index)
 	{
 		size_t i;
 
-		for (i = index; src[i]; ++i)
+		for (i = index; i < srcLength; ++i)
 		{
 			if (src[i] == '\n')
 			{
@@ -48,13 +37,13 @@ namespace hirzel::json
 		return i;
 	}
 
-	static size_t getEndOfBlockCommentIndex(const char* src, size_t index)
+	static size_t getEndOfBlockCommentIndex(const char* src, size_t srcLength, size_t index)
 	{
 		size_t i;
 
-		for (i = index; src[i]; ++i)
+		for (i = index; i < srcLength; ++i)
 		{
-			if (src[i] == '*' && src[i + 1] == '/')
+			if (src[i] == '*' && i + 1 < srcLength && src[i + 1] == '/')
 			{
 				i += 2;
 				break;
@@ -64,27 +53,28 @@ namespace hirzel::json
 		return i;
 	}
 
-	static size_t getNextTokenIndex(const char* src, size_t index)
+	static size_t getNextTokenIndex(const char* src, size_t srcLength, size_t index)
 	{
 		size_t i;
 
-		for (i = index; src[i]; ++i)
+		for (i = index; i < srcLength; ++i)
 		{
-			auto c = src[i];
+			auto c = (unsigned char)src[i];
 
-			if (c <= ' ')
+			// A NUL inside the text is not whitespace but an invalid token.
+			if (c <= ' ' && c != '\0')
 				continue;
 
-			if (c == '/')
+			if (c == '/' && i + 1 < srcLength)
 			{
 				switch (src[i + 1])
 				{
 					case '/':
-						i = getEndOfLineCommentIndex(src, i + 2) - 1;
+						i = getEndOfLineCommentIndex(src, srcLength, i + 2) - 1;
 						continue;
 
 					case '*':
-						i = getEndOfBlockCommentIndex(src, i + 2) - 1;
+						i = getEndOfBlockCommentIndex(src, srcLength, i + 2) - 1;
 						continue;
 
 					default:
@@ -98,35 +88,35 @@ namespace hirzel::json
 		return i;
 	}
 
-	std::optional<Token> Token::parse(const char* src, const size_t index)
+	std::optional<Token> Token::parseAt(const char* src, const size_t srcLength, const size_t index, ParseError* error)
 	{
+		if (index >= srcLength)
+			return Token(src, srcLength, srcLength, 0, TokenType::EndOfFile);
+
 		auto c = src[index];
 
 		switch (c)
 		{
-			case '\0':
-				return Token(src, index, 0, TokenType::EndOfFile);
-
 			case '{':
-				return Token(src, index, 1, TokenType::LeftBrace);
+				return Token(src, srcLength, index, 1, TokenType::LeftBrace);
 
 			case '}':
-				return Token(src, index, 1, TokenType::RightBrace);
+				return Token(src, srcLength, index, 1, TokenType::RightBrace);
 
 			case '[':
-				return Token(src, index, 1, TokenType::LeftBracket);
+				return Token(src, srcLength, index, 1, TokenType::LeftBracket);
 
 			case ']':
-				return Token(src, index, 1, TokenType::RightBracket);
+				return Token(src, srcLength, index, 1, TokenType::RightBracket);
 
 			case ',':
-				return Token(src, index, 1, TokenType::Comma);
+				return Token(src, srcLength, index, 1, TokenType::Comma);
 
 			case ':':
-				return Token(src, index, 1, TokenType::Colon);
+				return Token(src, srcLength, index, 1, TokenType::Colon);
 
 			case '\"':
-				return Token::parseString(src, index);
+				return Token::parseString(src, srcLength, index, error);
 
 			case '0':
 			case '1':
@@ -139,30 +129,30 @@ namespace hirzel::json
 			case '8':
 			case '9':
 			case '-':
-				return Token::parseNumber(src, index);
+				return Token::parseNumber(src, srcLength, index, error);
 
 			case 't':
-				return Token::parseTrue(src, index);
+				return Token::parseTrue(src, srcLength, index, error);
 
 			case 'f':
-				return Token::parseFalse(src, index);
+				return Token::parseFalse(src, srcLength, index, error);
 
 			case 'n':
-				return Token::parseNull(src, index);
+				return Token::parseNull(src, srcLength, index, error);
 
 			default:
 				break;
 		}
 
-		parseError("token", index, "Invalid character.");
+		parseError(error, ErrorCode::InvalidCharacter, src, srcLength, index, 1, "Invalid character.");
 		return {};
 	}
 
-	std::optional<Token> Token::parseString(const char* src, const size_t startIndex)
+	std::optional<Token> Token::parseString(const char* src, const size_t srcLength, const size_t startIndex, ParseError* error)
 	{
 		if (src[startIndex] != '\"')
 		{
-			parseError("string", startIndex, "String must begin with '\"'.");
+			parseError(error, ErrorCode::InvalidString, src, srcLength, startIndex, 1, "String must begin with '\"'.");
 			return {};
 		}
 
@@ -170,34 +160,57 @@ namespace hirzel::json
 
 		while (true)
 		{
-			if (src[i] == '\"')
-				break;
+			const auto* quote = i < srcLength
+				? (const char*)memchr(src + i, '\"', srcLength - i)
+				: nullptr;
 
-			if (src[i] == '\0')
+			if (!quote)
 			{
-				parseError("string", startIndex, "String is unterminated.");
+				parseError(error, ErrorCode::UnterminatedString, src, srcLength, startIndex, srcLength - startIndex, "String is unterminated.");
 				return {};
 			}
 
+			i = quote - src;
+
+			// A quote preceded by an odd number of backslashes is escaped and
+			// does not end the string.
+			size_t backslashCount = 0;
+
+			while (src[i - backslashCount - 1] == '\\')
+				backslashCount += 1;
+
 			i += 1;
+
+			if (backslashCount % 2 == 0)
+				break;
 		}
 
-		i += 1;
+		return Token(src, srcLength, startIndex, i - startIndex, TokenType::String);
+	}
 
-		return Token(src, startIndex, i - startIndex, TokenType::String);
+	static bool isDigitAt(const char* src, size_t srcLength, size_t index)
+	{
+		return index < srcLength && src[index] >= '0' && src[index] <= '9';
+	}
+
+	static char charAt(const char* src, size_t srcLength, size_t index)
+	{
+		return index < srcLength
+			? src[index]
+			: '\0';
 	}
 
-	static size_t numberLength(const char* const src)
+	static size_t numberLength(const char* src, size_t srcLength, size_t index)
 	{
-		const char *iter = src;
+		auto i = index;
 
-		while (isdigit(*iter))
-			iter += 1;
+		while (isDigitAt(src, srcLength, i))
+			i += 1;
 
-		return iter - src;
+		return i - index;
 	}
 
-	std::optional<Token> Token::parseNumber(const char* src, const size_t start)
+	std::optional<Token> Token::parseNumber(const char* src, const size_t srcLength, const size_t start, ParseError* error)
 	{
 		auto i = start;
 
@@ -205,33 +218,34 @@ namespace hirzel::json
 		{
 			i += 1;
 
-			if (!isdigit(src[i]))
+			if (!isDigitAt(src, srcLength, i))
 			{
-				parseError("number", start, "A number must follow '-'.");
+				parseError(error, ErrorCode::InvalidNumber, src, srcLength, start, i - start, "A number must follow '-'.");
 				return {};
 			}
 		}
 
-		i += numberLength(&src[i]);
+		i += numberLength(src, srcLength, i);
 
-		if (src[i] == '.')
+		if (charAt(src, srcLength, i) == '.')
 		{
 			i += 1;
 
-			auto fractionLength = numberLength(&src[i]);
+			auto fractionLength = numberLength(src, srcLength, i);
 
 			if (fractionLength == 0)
 			{
-				parseError("number", start, "A number must follow the decimal point.");
+				parseError(error, ErrorCode::InvalidNumber, src, srcLength, start, i - start, "A number must follow the decimal point.");
+				return {};
 			}
 
 			i += fractionLength;
 		}
 
-		switch (src[i])
+		switch (charAt(src, srcLength, i))
 		{
 		case '.':
-			parseError("number", start, "Invalid number format.");
+			parseError(error, ErrorCode::InvalidNumber, src, srcLength, start, i - start, "Invalid number format.");
 			return {};
 
 		case 'e':
@@ -239,19 +253,22 @@ namespace hirzel::json
 		{
 			i += 1;
 
-			auto exponentLength = numberLength(&src[i]);
+			if (charAt(src, srcLength, i) == '+' || charAt(src, srcLength, i) == '-')
+				i += 1;
+
+			auto exponentLength = numberLength(src, srcLength, i);
 
 			if (exponentLength == 0)
 			{
-				parseError("number", start, "Exponent is missing.");
+				parseError(error, ErrorCode::InvalidNumber, src, srcLength, start, i - start, "Exponent is missing.");
 				return {};
 			}
 
 			i += exponentLength;
 
-			if (src[i] == '.')
+			if (charAt(src, srcLength, i) == '.')
 			{
-				parseError("number", start, "Exponents must be integers.");
+				parseError(error, ErrorCode::InvalidNumber, src, srcLength, start, i - start, "Exponents must be integers.");
 				return {};
 			}
 			break;
@@ -262,71 +279,76 @@ namespace hirzel::json
 		}
 
 		auto length = i - start;
-		auto token =  Token(src, start, length, TokenType::Number);
+		auto token =  Token(src, srcLength, start, length, TokenType::Number);
 
 		return token;
 	}
 
-	static bool parseKeyword(const char* src, const size_t startIndex, const char* keyword, const size_t keywordLength)
+	static bool parseKeyword(const char* src, const size_t srcLength, const size_t startIndex, const char* keyword, const size_t keywordLength, ParseError* error)
 	{
 		auto endIndex = startIndex;
 
-		while (isalpha(src[endIndex]))
+		while (endIndex < srcLength && isalpha((unsigned char)src[endIndex]))
 			endIndex += 1;
 
 		const auto length = endIndex - startIndex;
 
-		if (length != keywordLength || strncmp(keyword, &src[startIndex], keywordLength))
+		if (length != keywordLength || memcmp(keyword, &src[startIndex], keywordLength))
 		{
-			parseError(keyword, startIndex, "Invalid keyword.");
+			parseError(error, ErrorCode::InvalidKeyword, src, srcLength, startIndex, length, "Invalid keyword.");
 			return false;
 		}
 		
 		return true;
 	}
 
-	std::optional<Token> Token::parseTrue(const char* src, const size_t startIndex)
+	std::optional<Token> Token::parseTrue(const char* src, const size_t srcLength, const size_t startIndex, ParseError* error)
 	{
 		const size_t length = 4;
 
-		if (!parseKeyword(src, startIndex, "true", length))
+		if (!parseKeyword(src, srcLength, startIndex, "true", length, error))
 			return {};
 
-		return Token(src, startIndex, length, TokenType::True);
+		return Token(src, srcLength, startIndex, length, TokenType::True);
 	}
 
-	std::optional<Token> Token::parseFalse(const char* src, const size_t startIndex)
+	std::optional<Token> Token::parseFalse(const char* src, const size_t srcLength, const size_t startIndex, ParseError* error)
 	{
 		const size_t length = 5;
 
-		if (!parseKeyword(src, startIndex, "false", length))
+		if (!parseKeyword(src, srcLength, startIndex, "false", length, error))
 			return {};
 
-		return Token(src, startIndex, length, TokenType::False);
+		return Token(src, srcLength, startIndex, length, TokenType::False);
 	}
 
-	std::optional<Token> Token::parseNull(const char* src, const size_t startIndex)
+	std::optional<Token> Token::parseNull(const char* src, const size_t srcLength, const size_t startIndex, ParseError* error)
 	{
 		const size_t length = 4;
 
-		if (!parseKeyword(src, startIndex, "null", length))
+		if (!parseKeyword(src, srcLength, startIndex, "null", length, error))
 			return {};
 
-		return Token(src, startIndex, length, TokenType::Null);
+		return Token(src, srcLength, startIndex, length, TokenType::Null);
+	}
+
+	std::optional<Token> Token::parse(const char* src, ParseError* error)
+	{
+		return parse(src, strlen(src), error);
 	}
 
-	std::optional<Token> Token::parse(const char* src)
+	std::optional<Token> Token::parse(const char* src, size_t srcLength, ParseError* error)
 	{
-		auto index = getNextTokenIndex(src, 0);
-		auto token = parse(src, index);
+		auto index = getNextTokenIndex(src, srcLength, 0);
+		auto token = parseAt(src, srcLength, index, error);
 
 		return token;
 	}
 
-	std::optional<Token> Token::parseNext() const
+	std::optional<Token> Token::parseNext(ParseError* error) const
 	{
-		auto index = getNextTokenIndex(_src, _index + _length);
-		auto token = parse(_src, index);
+		auto index = getNextTokenIndex(_src, _srcLength, _index + _length);
+		auto token = parseAt(_src, _srcLength, index, error);
 
 		return token;
 	}
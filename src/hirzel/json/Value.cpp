@@ -4,40 +4,112 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 #include <stdexcept>
 #include <string>
 
 namespace hirzel::json
 {
+	// Container nodes are allocated from the same memory resource as the
+	// container's elements, so a container built in an Arena is placed
+	// entirely in that Arena and is released with it.
+	template <typename Container>
+	static ContainerNode<Container>* createContainer(Container&& container)
+	{
+		using Node = ContainerNode<Container>;
+
+		auto* resource = container.get_allocator().resource();
+		auto* node = resource->allocate(sizeof(Node), alignof(Node));
+		auto isShareable = resource == std::pmr::get_default_resource();
+
+		return new (node) Node(std::move(container), isShareable);
+	}
+
+	template <typename Container>
+	static ContainerNode<Container>* copyContainer(const Container& container)
+	{
+		using Node = ContainerNode<Container>;
+
+		auto* resource = std::pmr::get_default_resource();
+		auto* node = resource->allocate(sizeof(Node), alignof(Node));
+
+		try
+		{
+			return new (node) Node(container, resource);
+		}
+		catch (...)
+		{
+			resource->deallocate(node, sizeof(Node), alignof(Node));
+			throw;
+		}
+	}
+
+	template <typename Container>
+	static ContainerNode<Container>* shareContainer(ContainerNode<Container>* node)
+	{
+		if (!node->isShareable)
+			return copyContainer(node->container);
+
+		node->referenceCount.fetch_add(1, std::memory_order_relaxed);
+
+		return node;
+	}
+
+	template <typename Container>
+	static void releaseContainer(ContainerNode<Container>* node)
+	{
+		using Node = ContainerNode<Container>;
+
+		if (node->referenceCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		auto* resource = node->container.get_allocator().resource();
+
+		node->~Node();
+		resource->deallocate(node, sizeof(Node), alignof(Node));
+	}
+
+	// Gives the caller a node that no other value refers to.
+	template <typename Container>
+	static ContainerNode<Container>* detachContainer(ContainerNode<Container>* node)
+	{
+		if (node->referenceCount.load(std::memory_order_acquire) == 1)
+			return node;
+
+		auto* copy = copyContainer(node->container);
+
+		releaseContainer(node);
+
+		return copy;
+	}
+
+	static_assert(sizeof(Value) == 16, "Values are expected to be two words");
+
 	Value::Value() :
-		_type(ValueType::Null),
-		_number(0)
+		_tag(0),
+		_type(ValueType::Null)
 	{}
 
 	Value::Value(ValueType type) :
-		_type(type),
-		_number(0)
+		_tag(0),
+		_type(type)
 	{
 		switch (type)
 		{
 			case ValueType::Number:
-				_number = 0.0;
+				setField(0.0);
 				break;
 
 			case ValueType::Boolean:
-				_boolean = false;
-				break;
-
-			case ValueType::String:
-				_string = new std::string();
+				setField(false);
 				break;
 
 			case ValueType::Array:
-				_array = new Array();
+				setField(createContainer(Array()));
 				break;
 
 			case ValueType::Object:
-				_object = new Object();
+				setField(createContainer(Object()));
 				break;
 
 			default:
@@ -46,269 +118,532 @@ namespace hirzel::json
 	}
 
 	Value::Value(short i) :
-		_type(ValueType::Number),
-		_number(i)
+		Value((long long)i)
 	{}
 
 	Value::Value(int i) :
-		_type(ValueType::Number),
-		_number(i)
+		Value((long long)i)
 	{}
 
 	Value::Value(long i) :
-		_type(ValueType::Number),
-		_number(i)
+		Value((long long)i)
 	{}
 
 	Value::Value(long long i) :
-		_type(ValueType::Number),
-		_number(i)
-	{}
+		_tag(integerTag),
+		_type(ValueType::Number)
+	{
+		setField((int64_t)i);
+	}
 
 	Value::Value(unsigned short i) :
-		_type(ValueType::Number),
-		_number(i)
+		Value((long long)i)
 	{}
 
 	Value::Value(unsigned int i) :
-		_type(ValueType::Number),
-		_number(i)
+		Value((long long)i)
 	{}
 
 	Value::Value(unsigned long i) :
-		_type(ValueType::Number),
-		_number(i)
+		Value((unsigned long long)i)
 	{}
 
 	Value::Value(unsigned long long i) :
-		_type(ValueType::Number),
-		_number(i)
-	{}
+		_tag(integerTag),
+		_type(ValueType::Number)
+	{
+		if (i <= (unsigned long long)INT64_MAX)
+		{
+			setField((int64_t)i);
+		}
+		else
+		{
+			_tag = 0;
+			setField((double)i);
+		}
+	}
 
 	Value::Value(float d) :
-		_type(ValueType::Number),
-		_number(d)
+		Value((double)d)
 	{}
 
 	Value::Value(double d) :
-		_type(ValueType::Number),
-		_number(d)
-	{}
+		_tag(0),
+		_type(ValueType::Number)
+	{
+		setField(d);
+	}
 
 	Value::Value(bool b) :
-		_type(ValueType::Boolean),
-		_boolean(b)
+		_tag(0),
+		_type(ValueType::Boolean)
+	{
+		setField(b);
+	}
+
+	// Strings borrowed from an Arena or a caller's buffer stay borrowed.
+	Value::Value(String&& s) :
+		_tag(0),
+		_type(ValueType::String)
+	{
+		if (s.isOwned())
+		{
+			setString(s.view());
+		}
+		else
+		{
+			setBorrowedString(s.view());
+		}
+	}
+
+	Value::Value(const String& s) :
+		Value(s.view())
 	{}
 
+	Value::Value(std::string_view s) :
+		_tag(0),
+		_type(ValueType::String)
+	{
+		setString(s);
+	}
+
 	Value::Value(std::string&& s) :
-		_type(ValueType::String),
-		_string(new std::string(std::move(s)))
+		Value(std::string_view(s))
 	{}
 
 	Value::Value(const std::string& s) :
-		_type(ValueType::String),
-		_string(new std::string(s))
+		Value(std::string_view(s))
 	{}
 
 	Value::Value(char* s) :
-		_type(ValueType::String),
-		_string(new std::string(s))
+		Value(std::string_view(s))
 	{}
 
 	Value::Value(const char* s) :
-		_type(ValueType::String),
-		_string(new std::string(s))
+		Value(std::string_view(s))
 	{}
 
+	Value::Value(std::string_view s, Arena& arena) :
+		_tag(0),
+		_type(ValueType::String)
+	{
+		if (s.length() <= inlineStringCapacity)
+		{
+			setString(s);
+			return;
+		}
+
+		// The arena releases the text, so the value only borrows it.
+		auto* data = (char*)arena.allocate(s.length(), 1);
+
+		memcpy(data, s.data(), s.length());
+		setBorrowedString({ data, s.length() });
+	}
+
 	Value::Value(Array&& array) :
-		_type(ValueType::Array),
-		_array(new Array(std::move(array)))
-	{}
+		_tag(0),
+		_type(ValueType::Array)
+	{
+		setField(createContainer(std::move(array)));
+	}
 
 	Value::Value(const Array& array) :
-		_type(ValueType::Array),
-		_array(new Array(array))
-	{}
+		_tag(0),
+		_type(ValueType::Array)
+	{
+		setField(copyContainer(array));
+	}
 
 	Value::Value(Object&& object) :
-		_type(ValueType::Object),
-		_object(new Object(std::move(object)))
-	{}
+		_tag(0),
+		_type(ValueType::Object)
+	{
+		setField(createContainer(std::move(object)));
+	}
 
 	Value::Value(const Object& object) :
-		_type(ValueType::Object),
-		_object(new Object(object))
-	{}
+		_tag(0),
+		_type(ValueType::Object)
+	{
+		setField(copyContainer(object));
+	}
 
+	// Every representation is trivially relocatable, so moving copies the
+	// storage and leaves other null so that it no longer owns anything.
 	Value::Value(Value&& other) noexcept :
-		_type(other._type),
-		_number(0)
+		_tag(other._tag),
+		_type(other._type)
+	{
+		memcpy(_storage, other._storage, sizeof(_storage));
+
+		other._tag = 0;
+		other._type = ValueType::Null;
+	}
+
+	Value::Value(const Value& other) :
+		_tag(other._tag),
+		_type(other._type)
 	{
 		switch (_type)
 		{
-		case ValueType::Null:
+		case ValueType::String:
+			// Copies own their text so that they may outlive the original.
+			_tag = 0;
+			setString(other.string());
 			break;
 
-		case ValueType::Number:
-			_number = other._number;
+		case ValueType::Array:
+			setField(shareContainer(other.field<ContainerNode<Array>*>()));
 			break;
 
-		case ValueType::Boolean:
-			_boolean = other._boolean;
+		case ValueType::Object:
+			setField(shareContainer(other.field<ContainerNode<Object>*>()));
 			break;
 
-		case ValueType::String:
-			_string = other._string;
-			other._string = nullptr;
+		default:
+			memcpy(_storage, other._storage, sizeof(_storage));
 			break;
+		}
+	}
 
-		case ValueType::Array:
-			_array = other._array;
-			other._array = nullptr;
-			break;
+	// If this value holds the last reference to its container, moves the
+	// children that are containers themselves into pending, so that they
+	// are released by the caller's loop instead of by recursion.
+	void Value::takeNestedContainers(std::vector<Value>& pending)
+	{
+		auto isContainer = [](const Value& value)
+		{
+			return value._type == ValueType::Array || value._type == ValueType::Object;
+		};
 
-		case ValueType::Object:
-			_object = other._object;
-			other._object = nullptr;
-			break;
+		if (_type == ValueType::Array)
+		{
+			auto* node = field<ContainerNode<Array>*>();
+
+			if (node->referenceCount.load(std::memory_order_acquire) != 1)
+				return;
+
+			for (auto& item : node->container)
+			{
+				if (isContainer(item))
+					pending.push_back(std::move(item));
+			}
 		}
+		else if (_type == ValueType::Object)
+		{
+			auto* node = field<ContainerNode<Object>*>();
 
-		other._type = ValueType::Null;
+			if (node->referenceCount.load(std::memory_order_acquire) != 1)
+				return;
+
+			for (auto& pair : node->container)
+			{
+				if (isContainer(pair.second))
+					pending.push_back(std::move(pair.second));
+			}
+		}
 	}
 
-	Value::Value(const Value& other) :
-		_type(other._type),
-		_number(0)
+	// Trees parsed with a large maxDepth can be deeper than the call stack
+	// allows, so nested containers are released iteratively.
+	Value::~Value()
 	{
 		switch (_type)
 		{
-		case ValueType::Null:
-			_number = 0;
+		case ValueType::String:
+			if (_tag == ownedStringTag)
+				delete[] field<const char*>();
 			break;
 
-		case ValueType::Number:
-			_number = other._number;
-			break;
+		case ValueType::Array:
+		case ValueType::Object:
+		{
+			auto pending = std::vector<Value>();
 
-		case ValueType::Boolean:
-			_boolean = other._boolean;
-			break;
+			takeNestedContainers(pending);
 
-		case ValueType::String:
-			_string = new std::string(*other._string);
-			break;
+			while (!pending.empty())
+			{
+				auto value = std::move(pending.back());
 
-		case ValueType::Array:
-			_array = new Array(*other._array);
+				pending.pop_back();
+				value.takeNestedContainers(pending);
+			}
+
+			if (_type == ValueType::Array)
+			{
+				releaseContainer(field<ContainerNode<Array>*>());
+			}
+			else
+			{
+				releaseContainer(field<ContainerNode<Object>*>());
+			}
 			break;
+		}
 
-		case ValueType::Object:
-			_object = new Object(*other._object);
+		default:
 			break;
 		}
 	}
 
-	Value::~Value()
+	void Value::seal()
+	{
+		if (_type == ValueType::Array)
+		{
+			field<ContainerNode<Array>*>()->isSealed = true;
+		}
+		else if (_type == ValueType::Object)
+		{
+			field<ContainerNode<Object>*>()->isSealed = true;
+		}
+	}
+
+	bool Value::isSealed() const
 	{
 		switch (_type)
 		{
-		case ValueType::String:
-			delete _string;
-			break;
+			case ValueType::Array:
+				return field<ContainerNode<Array>*>()->isSealed;
+
+			case ValueType::Object:
+				return field<ContainerNode<Object>*>()->isSealed;
+
+			default:
+				break;
+		}
+
+		return false;
+	}
+
+	Array& Value::array()
+	{
+		assert(_type == ValueType::Array);
+
+		auto*& node = field<ContainerNode<Array>*>();
+
+		// The seal is only cleared once the node is not shared, so that
+		// copies on other threads never see the write.
+		node = detachContainer(node);
+
+		if (node->isSealed)
+			node->isSealed = false;
+
+		return node->container;
+	}
+
+	Object& Value::object()
+	{
+		assert(_type == ValueType::Object);
+
+		auto*& node = field<ContainerNode<Object>*>();
+
+		// The seal is only cleared once the node is not shared, so that
+		// copies on other threads never see the write.
+		node = detachContainer(node);
 
+		if (node->isSealed)
+			node->isSealed = false;
+
+		return node->container;
+	}
+
+	bool Value::isShared() const
+	{
+		switch (_type)
+		{
 		case ValueType::Array:
-			delete _array;
-			break;
+			return field<ContainerNode<Array>*>()->referenceCount.load(std::memory_order_relaxed) > 1;
 
 		case ValueType::Object:
-			delete _object;
-			break;
+			return field<ContainerNode<Object>*>()->referenceCount.load(std::memory_order_relaxed) > 1;
 
 		default:
-			break;
+			return false;
 		}
 	}
 
+	Value Value::borrow(std::string_view s)
+	{
+		auto value = Value(ValueType::String);
+
+		value.setBorrowedString(s);
+
+		return value;
+	}
+
+	void Value::setString(std::string_view text)
+	{
+		if (text.length() <= inlineStringCapacity)
+		{
+			memcpy(_storage, text.data(), text.length());
+			_tag = (unsigned char)text.length();
+			return;
+		}
+
+		assert(text.length() <= UINT32_MAX);
+
+		auto* data = new char[text.length()];
+
+		memcpy(data, text.data(), text.length());
+		setField<const char*>(data);
+		setField<uint32_t, stringLengthOffset>((uint32_t)text.length());
+		_tag = ownedStringTag;
+	}
+
+	// Short strings are copied inline anyway, as that is no slower than
+	// referring to them.
+	void Value::setBorrowedString(std::string_view text)
+	{
+		if (text.length() <= inlineStringCapacity)
+		{
+			setString(text);
+			return;
+		}
+
+		assert(text.length() <= UINT32_MAX);
+
+		setField<const char*>(text.data());
+		setField<uint32_t, stringLengthOffset>((uint32_t)text.length());
+		_tag = borrowedStringTag;
+	}
+
 	Value& Value::operator=(Value&& other)
 	{
-		new (this) auto(std::move(other));
+		if (this == &other)
+			return *this;
+
+		// other may be owned by this value, so it is moved out before this
+		// value's contents are destroyed.
+		auto temp = Value(std::move(other));
+
+		this->~Value();
+		new (this) Value(std::move(temp));
 
 		return *this;
 	}
 
 	Value& Value::operator=(const Value& other)
 	{
-		new (this) auto(other);
+		if (this == &other)
+			return *this;
 
-		return *this;
+		auto copy = Value(other);
+
+		return *this = std::move(copy);
 	}
 
-	Value *Value::at(const std::string& key)
+	// Keys are either a std::string_view or a Key with a precomputed hash.
+	// Const values are searched through const accessors so that reading
+	// never clones a shared container.
+	template <typename V, typename K>
+	static V* findMember(V& value, const K& key)
 	{
-		if (_type != ValueType::Object)
+		if (!value.isObject())
 			return nullptr;
 
-		auto iter = _object->find(key);
-		auto *ptr = iter != _object->end()
+		auto& object = value.object();
+		auto iter = object.find(key);
+		auto *ptr = iter != object.end()
 			? &iter->second
 			: nullptr;
 
 		return ptr;
 	}
 
-	const Value *Value::at(const std::string& key) const
+	Value *Value::at(std::string_view key)
 	{
-		if (_type != ValueType::Object)
-			return nullptr;
+		return findMember(*this, key);
+	}
 
-		auto iter = _object->find(key);
-		auto *ptr = iter != _object->end()
-			? &iter->second
-			: nullptr;
+	const Value *Value::at(std::string_view key) const
+	{
+		return findMember(*this, key);
+	}
 
-		return ptr;
+	Value *Value::at(const Key& key)
+	{
+		return findMember(*this, key);
+	}
+
+	const Value *Value::at(const Key& key) const
+	{
+		return findMember(*this, key);
 	}
 
 	Value *Value::at(size_t i)
 	{
-		if (_type != ValueType::Array || i >= _array->size())
+		if (_type != ValueType::Array || i >= array().size())
 			return nullptr;
 
-		return &(*_array)[i];
+		return &array()[i];
 	}
 
 	const Value *Value::at(size_t i) const
 	{
-		return const_cast<Value&>(*this).at(i);
+		if (_type != ValueType::Array || i >= array().size())
+			return nullptr;
+
+		return &array()[i];
 	}
 
 	Value& Value::operator[](size_t i)
 	{
 		assert(_type == ValueType::Array);
-		assert(i < _array->size());
+		assert(i < array().size());
 
-		return (*_array)[i];
+		return array()[i];
 	}
 
 	const Value& Value::operator[](size_t i) const
 	{
-		return const_cast<Value&>(*this)[i];
+		assert(_type == ValueType::Array);
+		assert(i < array().size());
+
+		return array()[i];
 	}
 
-	Value& Value::operator[](const std::string& key)
+	Value& Value::operator[](std::string_view key)
 	{
 		assert(_type == ValueType::Object);
-		
-		auto iter = _object->find(key);
 
-		assert(iter != _object->end());
+		auto* member = findMember(*this, key);
 
-		return iter->second;
+		assert(member);
+
+		return *member;
 	}
 
-	const Value& Value::operator[](const std::string& key) const
+	const Value& Value::operator[](std::string_view key) const
 	{
-		return const_cast<Value&>(*this)[key];
+		assert(_type == ValueType::Object);
+
+		auto* member = findMember(*this, key);
+
+		assert(member);
+
+		return *member;
+	}
+
+	Value& Value::operator[](const Key& key)
+	{
+		assert(_type == ValueType::Object);
+
+		auto* member = findMember(*this, key);
+
+		assert(member);
+
+		return *member;
+	}
+
+	const Value& Value::operator[](const Key& key) const
+	{
+		assert(_type == ValueType::Object);
+
+		auto* member = findMember(*this, key);
+
+		assert(member);
+
+		return *member;
 	}
 
 	int64_t Value::asInteger() const
@@ -316,15 +651,15 @@ namespace hirzel::json
 		switch (_type)
 		{
 		case ValueType::Number:
-			return (int64_t)_number;
+			return integer();
 
 		case ValueType::Boolean:
-			return (int64_t)_boolean;
+			return (int64_t)boolean();
 
 		case ValueType::String:
 			try
 			{
-				return std::stoll(*_string);
+				return std::stoll(std::string(string()));
 			}
 			catch (const std::exception&)
 			{
@@ -343,15 +678,15 @@ namespace hirzel::json
 		switch (_type)
 		{
 		case ValueType::Number:
-			return _number;
+			return number();
 
 		case ValueType::Boolean:
-			return (double)_boolean;
+			return (double)boolean();
 			
 		case ValueType::String:
 			try
 			{
-				return std::stod(*_string);
+				return std::stod(std::string(string()));
 			}
 			catch (const std::exception&)
 			{
@@ -370,13 +705,15 @@ namespace hirzel::json
 		switch (_type)
 		{
 		case ValueType::Number:
-			return (bool)_number;
+			return isInteger()
+				? integer() != 0
+				: number() != 0.0;
 
 		case ValueType::Boolean:
-			return _boolean;
+			return boolean();
 
 		case ValueType::String:
-			return !_string->empty();
+			return !string().empty();
 
 		case ValueType::Array:
 			return true;
@@ -392,7 +729,7 @@ namespace hirzel::json
 	std::string Value::asString() const
 	{
 		if (_type == ValueType::String)
-			return *_string;
+			return std::string(string());
 
 		return serialize(*this);
 	}
@@ -402,13 +739,13 @@ namespace hirzel::json
 		switch (_type)
 		{
 		case ValueType::String:
-			return _string->empty();
+			return string().empty();
 
 		case ValueType::Array:
-			return _array->empty();
+			return array().empty();
 
 		case ValueType::Object:
-			return _object->empty();
+			return object().empty();
 
 		case ValueType::Null:
 			return true;
@@ -423,13 +760,13 @@ namespace hirzel::json
 		switch (_type)
 		{
 		case ValueType::String:
-			return _string->length();
+			return string().length();
 
 		case ValueType::Array:
-			return _array->size();
+			return array().size();
 
 		case ValueType::Object:
-			return _object->size();
+			return object().size();
 
 		default:
 			return 0;
@@ -448,17 +785,20 @@ namespace hirzel::json
 			return true;
 
 		case ValueType::Number:
-			return _number == other.number();
+			if (isInteger() && other.isInteger())
+				return integer() == other.integer();
+
+			return number() == other.number();
 
 		case ValueType::Boolean:
-			return _boolean == other.boolean();
+			return boolean() == other.boolean();
 
 		case ValueType::String:
-			return *_string == other.string();
+			return string() == other.string();
 
 		case ValueType::Array:
 		{
-			const auto& arr = *_array;
+			const auto& arr = array();
 			const auto& oarr = other.array();
 
 			if (arr.size() != oarr.size())
@@ -475,7 +815,7 @@ namespace hirzel::json
 
 		case ValueType::Object:
 		{
-			const auto& aTable = *_object;
+			const auto& aTable = object();
 			const auto& bTable = other.object();
 
 			if (aTable.size() != bTable.size())
@@ -503,9 +843,13 @@ namespace hirzel::json
 
 	std::ostream& operator<<(std::ostream& out, const Value& json)
 	{
-		auto text = json.asString();
+		// Strings are printed as their text, as with asString().
+		if (json.isString())
+			return out << json.string();
+
+		auto writer = StreamWriter(out);
 
-		out << text;
+		serialize(json, writer);
 
 		return out;
 	}
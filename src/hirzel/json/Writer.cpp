@@ -0,0 +1,225 @@
+#include "hirzel/json/Writer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <unistd.h>
+
+namespace hirzel::json
+{
+	Writer::Writer():
+		_begin(nullptr),
+		_position(nullptr),
+		_end(nullptr),
+		_isFailed(false)
+	{}
+
+	Writer::Writer(char* begin, char* end):
+		_begin(begin),
+		_position(begin),
+		_end(end),
+		_isFailed(false)
+	{}
+
+	void Writer::setBuffer(char* begin, char* end, size_t length)
+	{
+		_begin = begin;
+		_position = begin + length;
+		_end = end;
+	}
+
+	bool Writer::writeSlow(const char* data, size_t length)
+	{
+		if (_isFailed)
+			return false;
+
+		while (length > 0)
+		{
+			if (_position == _end && !overflow(length))
+			{
+				_isFailed = true;
+				return false;
+			}
+
+			auto count = std::min(length, (size_t)(_end - _position));
+
+			memcpy(_position, data, count);
+			_position += count;
+			data += count;
+			length -= count;
+		}
+
+		return true;
+	}
+
+	bool Writer::overflow(size_t)
+	{
+		if (!drain(_begin, _position - _begin))
+			return false;
+
+		_position = _begin;
+
+		return _position != _end;
+	}
+
+	char* Writer::reserve(size_t length)
+	{
+		if (_isFailed)
+			return nullptr;
+
+		if ((size_t)(_end - _position) >= length)
+			return _position;
+
+		// Text that may be shorter than length can still fit in what is
+		// left, so the caller writes it instead, which only overflows once
+		// the buffer is full.
+		if (_position != _end)
+			return nullptr;
+
+		if (!overflow(length))
+		{
+			_isFailed = true;
+			return nullptr;
+		}
+
+		if ((size_t)(_end - _position) < length)
+			return nullptr;
+
+		return _position;
+	}
+
+	bool Writer::flush()
+	{
+		if (_isFailed)
+			return false;
+
+		if (_position == _begin)
+			return true;
+
+		if (!drain(_begin, _position - _begin))
+		{
+			_isFailed = true;
+			return false;
+		}
+
+		_position = _begin;
+
+		return true;
+	}
+
+	StringWriter::StringWriter():
+		StringWriter(256)
+	{}
+
+	StringWriter::StringWriter(size_t capacity):
+		_text(std::max(capacity, (size_t)1), '\0')
+	{
+		setBuffer(_text.data(), _text.data() + _text.size(), 0);
+	}
+
+	bool StringWriter::overflow(size_t length)
+	{
+		auto used = (size_t)(position() - begin());
+
+		_text.resize(std::max(_text.size() * 2, used + length));
+		setBuffer(_text.data(), _text.data() + _text.size(), used);
+
+		return true;
+	}
+
+	bool StringWriter::drain(const char*, size_t)
+	{
+		return true;
+	}
+
+	bool StringWriter::flush()
+	{
+		return !isFailed();
+	}
+
+	std::string StringWriter::release()
+	{
+		auto used = (size_t)(position() - begin());
+		auto text = std::move(_text);
+
+		text.resize(used);
+		_text.clear();
+		setBuffer(_text.data(), _text.data(), 0);
+
+		return text;
+	}
+
+	StreamWriter::StreamWriter(std::ostream& out):
+		Writer(_buffer, _buffer + sizeof(_buffer)),
+		_out(out)
+	{}
+
+	StreamWriter::~StreamWriter()
+	{
+		flush();
+	}
+
+	bool StreamWriter::drain(const char* data, size_t length)
+	{
+		_out.write(data, length);
+
+		return !!_out;
+	}
+
+	FileDescriptorWriter::FileDescriptorWriter(int fd):
+		Writer(_buffer, _buffer + sizeof(_buffer)),
+		_fd(fd)
+	{}
+
+	FileDescriptorWriter::~FileDescriptorWriter()
+	{
+		flush();
+	}
+
+	bool FileDescriptorWriter::drain(const char* data, size_t length)
+	{
+		while (length > 0)
+		{
+			auto count = ::write(_fd, data, length);
+
+			if (count < 0)
+			{
+				if (errno == EINTR)
+					continue;
+
+				return false;
+			}
+
+			data += count;
+			length -= count;
+		}
+
+		return true;
+	}
+
+	SpanWriter::SpanWriter(char* buffer, size_t size, std::function<bool(const char* data, size_t length)> onOverflow):
+		Writer(buffer, buffer + size),
+		_onOverflow(std::move(onOverflow))
+	{}
+
+	SpanWriter::~SpanWriter()
+	{
+		flush();
+	}
+
+	bool SpanWriter::flush()
+	{
+		// Without a callback the text is left in the buffer for the caller.
+		if (!_onOverflow)
+			return !isFailed();
+
+		return Writer::flush();
+	}
+
+	bool SpanWriter::drain(const char* data, size_t length)
+	{
+		if (!_onOverflow)
+			return false;
+
+		return _onOverflow(data, length);
+	}
+}
@@ -0,0 +1,56 @@
+#include "hirzel/json/Arena.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+using namespace hirzel::json;
+
+void testAllocate()
+{
+	auto arena = Arena(64);
+	auto* a = (char*)arena.allocate(16, 1);
+	auto* b = (char*)arena.allocate(16, 1);
+
+	assert(a != nullptr);
+	assert(b != nullptr);
+	assert(a != b);
+
+	memset(a, 'a', 16);
+	memset(b, 'b', 16);
+
+	assert(a[15] == 'a');
+	assert(b[0] == 'b');
+}
+
+void testAlignment()
+{
+	auto arena = Arena();
+
+	arena.allocate(1, 1);
+
+	auto* ptr = arena.allocate(sizeof(double), alignof(double));
+
+	assert((uintptr_t)ptr % alignof(double) == 0);
+}
+
+void testGrowth()
+{
+	auto arena = Arena(16);
+
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		auto* ptr = (char*)arena.allocate(128, 1);
+
+		memset(ptr, 0, 128);
+	}
+}
+
+int main()
+{
+	testAllocate();
+	testAlignment();
+	testGrowth();
+
+	return 0;
+}
@@ -1,7 +1,12 @@
 #include "hirzel/json/Deserialization.hpp"
+#include "hirzel/json/Error.hpp"
+#include "hirzel/json/Serialization.hpp"
 #include "hirzel/json/ValueType.hpp"
 
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
 
 using namespace hirzel::json;
 
@@ -37,6 +42,16 @@ void testNumber()
 	assert(deserialize("123")->number() == 123);
 	assert(confirmDeserialization("123.456", ValueType::Number));
 	assert(deserialize("123.456")->number() == 123.456);
+	assert(deserialize("-1.5e-3")->number() == -1.5e-3);
+	assert(deserialize("2E+2")->number() == 200.0);
+	assert(deserialize("9007199254740993")->integer() == 9007199254740993);
+	assert(deserialize("-9223372036854775808")->integer() == INT64_MIN);
+	assert(deserialize("123")->isInteger());
+	assert(!deserialize("1.0")->isInteger());
+	assert(!deserialize("1."));
+	assert(!deserialize("1e400"));
+	assert(deserialize("1e-400")->number() == 0.0);
+	assert((*deserialize("[1e-400, -1e-400]"))[1].number() == 0.0);
 }
 
 void testBoolean()
@@ -173,6 +188,274 @@ void testObject()
 	}));
 }
 
+bool isInside(const char* json, std::string_view text)
+{
+	return text.data() >= json && text.data() + text.length() <= json + strlen(json);
+}
+
+void testBorrowedStrings()
+{
+	auto options = DeserializationOptions();
+
+	options.borrowStrings = true;
+
+	const auto* json = R"({ "key": "a value that is too long to be inline", "list": ["abc", "a string with \n an escape"] })";
+	auto value = deserialize(json, options);
+
+	assert(value);
+	assert((*value)["key"].string() == "a value that is too long to be inline");
+	assert((*value)["key"].isBorrowedString());
+	assert(isInside(json, (*value)["key"].string()));
+	// Short strings are copied inline and escaped strings are copied.
+	assert(!(*value)["list"][0].isBorrowedString());
+	assert(!isInside(json, (*value)["list"][0].string()));
+	assert(!isInside(json, (*value)["list"][1].string()));
+
+	for (const auto& pair : value->object())
+		assert(isInside(json, pair.first));
+
+	auto copy = Value(*value);
+
+	assert(!isInside(json, copy["key"].string()));
+	assert(copy == *value);
+
+	auto document = deserializeDocument(json, options);
+
+	assert(document);
+	assert(isInside(json, document->root()["key"].string()));
+	assert(!isInside(json, deserialize(json)->at("key")->string()));
+}
+
+void testComments()
+{
+	auto value = deserialize(R"(
+		// line comment
+		[1, /* block comment */ "a"]
+	)");
+
+	assert(value);
+	assert(value->length() == 2);
+	assert((*value)[1].string() == "a");
+}
+
+void testInvalid()
+{
+	assert(!deserialize(""));
+	assert(!deserialize("123abc"));
+	assert(!deserialize("[1-2]"));
+	assert(!deserialize("[true false]"));
+	assert(!deserialize("[nullx]"));
+	assert(!deserialize("{\"a\" 1}"));
+	assert(!deserialize("[1, 2"));
+	assert(!deserialize("\"unterminated"));
+	assert(!deserialize("[1] 2"));
+}
+
+void testLength()
+{
+	const char* json = "[1, \"abc\", 3]garbage";
+	auto value = deserialize(json, 13);
+
+	assert(value);
+	assert(value->length() == 3);
+	assert((*value)[1].string() == "abc");
+	assert(!deserialize(json, 12));
+	assert(!deserialize(json, strlen(json)));
+
+	auto view = std::string_view("{\"a\": true} {\"b\": false}");
+
+	assert(deserialize(view.substr(0, 11))->at("a")->boolean());
+	assert(deserialize(view.substr(12))->at("b")->boolean() == false);
+	assert(deserializeDocument(view.substr(12)));
+
+	// A number at the end of a span stops there rather than at the terminator.
+	assert(deserialize("12345", 2)->integer() == 12);
+	assert(deserialize(std::string("1\0", 2)) == std::nullopt);
+}
+
+void testParallel()
+{
+	auto text = std::string("[");
+
+	for (size_t i = 0; i < 500; ++i)
+	{
+		if (i > 0)
+			text += ", ";
+
+		switch (i % 5)
+		{
+			case 0:
+				text += std::to_string(i);
+				break;
+
+			case 1:
+				text += "\"text, with [brackets] and \\\" quotes\"";
+				break;
+
+			case 2:
+				text += "{ \"a\": [1, 2, { \"b\": null }], \"c\": \"}\" }";
+				break;
+
+			case 3:
+				text += "[]";
+				break;
+
+			default:
+				text += "true";
+				break;
+		}
+	}
+
+	text += "]";
+
+	auto pool = ThreadPool(4);
+	auto options = ParallelDeserializationOptions();
+
+	options.pool = &pool;
+	options.minParallelLength = 0;
+
+	auto expected = deserialize(text);
+	auto value = deserializeParallel(text, options);
+
+	assert(expected);
+	assert(value);
+	assert(value->length() == 500);
+	assert(*value == *expected);
+
+	assert(deserializeParallel("[]", options)->length() == 0);
+	assert(deserializeParallel("[1]", options)->length() == 1);
+	assert(deserializeParallel("{\"a\": [1, 2]}", options)->isObject());
+	assert(!deserializeParallel("[1, 2 3]", options));
+	assert(!deserializeParallel("[1, {], 3]", options));
+	assert(!deserializeParallel("[1, 2] 3", options));
+	assert(!deserializeParallel("[1, 2, 3", options));
+	assert(!deserializeParallel("[1, 2abc, 3]", options));
+}
+
+void testExactSize()
+{
+	auto value = deserialize(R"([[1, 2, 3, 4, 5], { "a": [[], [true]], "b": 2, "c": 3 }, "x"])");
+
+	assert(value);
+	assert(value->array().capacity() == 3);
+	assert((*value)[0].array().capacity() == 5);
+	assert((*value)[1]["a"].array().capacity() == 2);
+	assert((*value)[1]["a"][1].array().capacity() == 1);
+	assert((*value)[1]["a"][1][0] == Value(true));
+	assert((*value)[1].object().begin()[2].second == Value(3));
+	assert((*value)[2].string() == "x");
+}
+
+void testEscapes()
+{
+	const auto* json = R"({"say \"hi\"": "line\nbreak \u00e9 \ud83d\ude00 a longer tail to leave the inline storage", "b": "\/"})";
+	auto decodedKey = std::string("say \"hi\"");
+	auto decoded = std::string("line\nbreak \xc3\xa9 \xf0\x9f\x98\x80 a longer tail to leave the inline storage");
+	auto value = deserialize(json);
+
+	assert(value);
+	assert((*value)[decodedKey].string() == decoded);
+	assert((*value)["b"].string() == "/");
+
+	// Escaped strings are decoded even when others are borrowed.
+	auto options = DeserializationOptions();
+
+	options.borrowStrings = true;
+
+	auto document = deserializeDocument(json, options);
+
+	assert(document);
+	assert(document->root()[decodedKey].string() == decoded);
+
+	auto keyPool = KeyPool();
+
+	options.keyPool = &keyPool;
+
+	assert(deserialize(json, options)->contains(decodedKey));
+	assert(deserializeDocument(json, options)->root().contains(decodedKey));
+
+	// Serializing escapes the text again.
+	assert(*deserialize(serialize(*value)) == *value);
+
+	assert(!deserialize(R"(["\x"])"));
+	assert(!deserialize(R"(["\ud83d"])"));
+	assert(!deserialize(R"({"\u12": 1})"));
+}
+
+static std::string nested(size_t depth)
+{
+	auto text = std::string();
+
+	for (size_t i = 0; i < depth; ++i)
+		text += (i % 2) ? "{\"a\":" : "[";
+
+	text += "0";
+
+	for (size_t i = depth; i-- > 0;)
+		text += (i % 2) ? "}" : "]";
+
+	return text;
+}
+
+void testDepth()
+{
+	auto options = DeserializationOptions();
+	auto errorCount = 0;
+
+	options.maxDepth = 4;
+
+	onError([&](const char*)
+	{
+		errorCount += 1;
+	});
+
+	assert(deserialize(nested(4), options));
+	assert(!deserialize(nested(5), options));
+	assert(errorCount == 1);
+	assert(!deserialize(nested(1000000)));
+	assert(errorCount == 2);
+
+	onError(nullptr);
+
+	auto parallelOptions = ParallelDeserializationOptions();
+
+	parallelOptions.minParallelLength = 0;
+	parallelOptions.deserialization.maxDepth = 4;
+
+	assert(deserializeParallel("[[{\"a\": [1]}], 2]", parallelOptions));
+	assert(!deserializeParallel("[[{\"a\": [[1]]}], 2]", parallelOptions));
+
+	// Parallel and serial parsing agree at the smallest limit.
+	options.maxDepth = 1;
+	parallelOptions.deserialization.maxDepth = 1;
+
+	for (auto json : { "[1, 2, 3]", "[1, [2], 3]", "[1, {}, 3]", "[]" })
+		assert(deserialize(json, options).has_value() == deserializeParallel(json, parallelOptions).has_value());
+
+	assert(deserializeParallel("[1, 2, 3]", parallelOptions));
+	assert(!deserializeParallel("[1, [2], 3]", parallelOptions));
+}
+
+void testDeepNesting()
+{
+	// Neither parsing nor releasing the tree uses the call stack per level.
+	auto options = DeserializationOptions();
+
+	options.maxDepth = 0;
+
+	auto value = deserialize(nested(1000000), options);
+
+	assert(value);
+	assert(value->isArray());
+	assert((*value)[0]["a"][0].isObject());
+
+	auto documentOptions = DeserializationOptions();
+
+	documentOptions.maxDepth = 0;
+
+	assert(deserializeDocument(nested(1000000), documentOptions));
+}
+
 int main()
 {
 	testNull();
@@ -181,6 +464,15 @@ int main()
 	testString();
 	testArray();
 	testObject();
+	testBorrowedStrings();
+	testComments();
+	testInvalid();
+	testLength();
+	testParallel();
+	testExactSize();
+	testEscapes();
+	testDepth();
+	testDeepNesting();
 
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "hirzel/json/Deserialization.hpp"
+#include "hirzel/json/Document.hpp"
+
+#include <cassert>
+
+using namespace hirzel::json;
+
+void testEmpty()
+{
+	auto document = Document();
+
+	assert(document.root().isNull());
+}
+
+void testDeserialize()
+{
+	auto document = deserializeDocument(R"(
+		{
+			"name": "a string that is longer than any small string buffer",
+			"values": [1, 2, 3, true, null],
+			"nested": { "key": "value" }
+		}
+	)");
+
+	assert(document);
+
+	const auto& root = document->root();
+
+	assert(root.isObject());
+	assert(root["name"].string() == "a string that is longer than any small string buffer");
+	assert(root["values"].length() == 5);
+	assert(root["values"][1].number() == 2);
+	assert(root["nested"]["key"].string() == "value");
+}
+
+void testInvalid()
+{
+	assert(!deserializeDocument("[1, 2"));
+	assert(!deserializeDocument("{ \"a\" }"));
+}
+
+void testCopyOutlivesDocument()
+{
+	auto copy = Value();
+
+	{
+		auto document = deserializeDocument(R"({ "list": ["abc", "def"] })");
+
+		assert(document);
+
+		copy = document->root()["list"];
+	}
+
+	assert(copy.isArray());
+	assert(copy[0].string() == "abc");
+	assert(copy[1].string() == "def");
+}
+
+void testMove()
+{
+	auto document = deserializeDocument("[\"abc\"]");
+
+	assert(document);
+
+	auto moved = std::move(*document);
+
+	assert(moved.root()[0].string() == "abc");
+
+	auto assigned = Document();
+
+	assigned = std::move(moved);
+
+	assert(assigned.root()[0].string() == "abc");
+}
+
+void testMutation()
+{
+	auto document = deserializeDocument("[\"abc\"]");
+
+	assert(document);
+
+	document->root().array().emplace_back("def");
+	document->root()[0] = Value("ghi");
+
+	assert(document->root()[0].string() == "ghi");
+	assert(document->root()[1].string() == "def");
+}
+
+void testTeardown()
+{
+	// Values that are not in the arena are released with the document even
+	// when they are added deep in a parsed tree.
+	auto document = deserializeDocument(R"([1, { "a": [2, { "b": [] }] }])");
+	const auto& root = document->root();
+
+	assert(root[1]["a"][1]["b"].length() == 0);
+
+	document->root()[1]["a"][1]["b"].array().push_back(Value("a string too long to be kept inline"));
+	document->root()[1]["a"].array().push_back(*deserialize("[[1, 2], {\"c\": [3]}]"));
+
+	assert(root[1]["a"][2][1]["c"][0] == Value(3));
+
+	auto replaced = deserializeDocument("{ \"a\": [1] }");
+
+	replaced->root() = *deserialize("[\"another string too long to be kept inline\"]");
+}
+
+int main()
+{
+	testEmpty();
+	testDeserialize();
+	testInvalid();
+	testCopyOutlivesDocument();
+	testMove();
+	testMutation();
+	testTeardown();
+
+	return 0;
+}
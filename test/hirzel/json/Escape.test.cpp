@@ -0,0 +1,117 @@
+#include "hirzel/json/Escape.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+using namespace hirzel::json;
+
+static std::optional<std::string> decode(std::string_view text)
+{
+	auto out = std::string(text.length(), '\0');
+	size_t errorOffset = 0;
+	auto length = unescape(text, out.data(), errorOffset);
+
+	if (!length)
+		return {};
+
+	out.resize(*length);
+
+	return out;
+}
+
+static size_t errorOffset(std::string_view text)
+{
+	auto out = std::string(text.length(), '\0');
+	size_t errorOffset = SIZE_MAX;
+
+	assert(!unescape(text, out.data(), errorOffset));
+
+	return errorOffset;
+}
+
+void testSimpleEscapes()
+{
+	assert(*decode("") == "");
+	assert(*decode("plain") == "plain");
+	assert(*decode(R"(\"\\\/\b\f\n\r\t)") == "\"\\/\b\f\n\r\t");
+	assert(*decode(R"(a\"b)") == "a\"b");
+}
+
+void testUnicodeEscapes()
+{
+	assert(*decode(R"(\u0041)") == "A");
+	assert(*decode(R"(\u00e9)") == "\xc3\xa9");
+	assert(*decode(R"(\u20AC)") == "\xe2\x82\xac");
+	assert(*decode(R"(\ud83d\ude00)") == "\xf0\x9f\x98\x80");
+	assert(*decode(R"(\u0000)") == std::string(1, '\0'));
+	assert(*decode(R"(x\ud834\udd1ey)") == "x\xf0\x9d\x84\x9ey");
+}
+
+void testInvalid()
+{
+	assert(errorOffset(R"(\x)") == 0);
+	assert(errorOffset(R"(ab\)") == 2);
+	assert(errorOffset(R"(\u12)") == 0);
+	assert(errorOffset(R"(\u12g4)") == 0);
+	assert(errorOffset(R"(a\ud83d)") == 1);
+	assert(errorOffset(R"(\ud83dA)") == 0);
+	assert(errorOffset(R"(\ude00)") == 0);
+}
+
+void testLongText()
+{
+	// Escapes at every position relative to the vector width, with runs
+	// long enough for the vector loops.
+	for (size_t prefix = 0; prefix < 70; ++prefix)
+	{
+		auto text = std::string(prefix, 'a') + "\\n" + std::string(prefix * 2, 'b') + "\\u00e9" + std::string(40, 'c');
+		auto expected = std::string(prefix, 'a') + "\n" + std::string(prefix * 2, 'b') + "\xc3\xa9" + std::string(40, 'c');
+
+		assert(*decode(text) == expected);
+	}
+
+	auto html = std::string();
+	auto expected = std::string();
+
+	for (size_t i = 0; i < 100; ++i)
+	{
+		html += R"(<a href=\"/page\">link<\/a>\n)";
+		expected += "<a href=\"/page\">link</a>\n";
+	}
+
+	assert(*decode(html) == expected);
+}
+
+void testFindEscapable()
+{
+	assert(findEscapable("", 0) == 0);
+	assert(findEscapable("abc", 0) == 3);
+	assert(findEscapable("a\"c", 0) == 1);
+	assert(findEscapable("a\"c", 2) == 3);
+	assert(findEscapable("a\\c", 0) == 1);
+	assert(findEscapable(std::string(1, '\x1f'), 0) == 0);
+	assert(findEscapable("\x7f\xc3\xa9 /", 0) == 5);
+
+	for (size_t position = 0; position < 100; ++position)
+	{
+		auto text = std::string(120, 'x');
+
+		text[position] = '\n';
+
+		assert(findEscapable(text, 0) == position);
+		assert(findEscapable(text, position + 1) == text.length());
+	}
+}
+
+int main()
+{
+	testSimpleEscapes();
+	testUnicodeEscapes();
+	testInvalid();
+	testLongText();
+	testFindEscapable();
+
+	return 0;
+}
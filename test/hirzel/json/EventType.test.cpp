@@ -0,0 +1,38 @@
+#include "hirzel/json/EventType.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+
+using namespace hirzel::json;
+
+bool checkStream(EventType eventType, const char *text)
+{
+	auto out = std::ostringstream();
+
+	out << eventType;
+
+	return out.str() == text;
+}
+
+int main()
+{
+	assert(!strcmp(eventTypeName(EventType::StartObject), "start of object"));
+	assert(!strcmp(eventTypeName(EventType::EndObject), "end of object"));
+	assert(!strcmp(eventTypeName(EventType::StartArray), "start of array"));
+	assert(!strcmp(eventTypeName(EventType::EndArray), "end of array"));
+	assert(!strcmp(eventTypeName(EventType::Key), "key"));
+	assert(!strcmp(eventTypeName(EventType::String), "string"));
+	assert(!strcmp(eventTypeName(EventType::Number), "number"));
+	assert(!strcmp(eventTypeName(EventType::Boolean), "boolean"));
+	assert(!strcmp(eventTypeName(EventType::Null), "null"));
+	assert(!strcmp(eventTypeName(EventType::EndOfFile), "end of file"));
+	assert(!strcmp(eventTypeName((EventType)-1), "invalid event"));
+
+	assert(checkStream(EventType::StartObject, "start of object"));
+	assert(checkStream(EventType::Key, "key"));
+	assert(checkStream(EventType::EndOfFile, "end of file"));
+	assert(checkStream((EventType)-1, "invalid event"));
+
+	return 0;
+}
@@ -0,0 +1,204 @@
+#include "hirzel/json/IncrementalParser.hpp"
+#include "hirzel/json/Deserialization.hpp"
+#include "hirzel/json/Serialization.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace hirzel::json;
+
+const char* stream = R"({ "item": [1, "a \"quoted\" } string", [1.5, -20, true]] }
+// comment with "quote" and ]
+"standalone" 12345 /* block * comment */ [null, { "a": {} }]
+false -0.25e+3)";
+
+const std::vector<std::string> expected = {
+	"{\"item\":[1,\"a \\\"quoted\\\" } string\",[1.5,-20,true]]}",
+	"\"standalone\"",
+	"12345",
+	"[null,{\"a\":{}}]",
+	"false",
+	"-250"
+};
+
+std::vector<std::string> parseInChunks(size_t chunkSize)
+{
+	auto parser = IncrementalParser();
+	auto length = strlen(stream);
+	auto results = std::vector<std::string>();
+
+	for (size_t i = 0; i < length; i += chunkSize)
+	{
+		auto size = std::min(chunkSize, length - i);
+
+		assert(parser.feed(stream + i, size));
+
+		while (auto value = parser.next())
+			results.push_back(serialize(*value));
+	}
+
+	assert(parser.finish());
+
+	while (auto value = parser.next())
+		results.push_back(serialize(*value));
+
+	return results;
+}
+
+void testWhole()
+{
+	assert(parseInChunks(strlen(stream)) == expected);
+}
+
+void testChunks()
+{
+	for (size_t chunkSize = 1; chunkSize < 16; ++chunkSize)
+		assert(parseInChunks(chunkSize) == expected);
+}
+
+void testValuesCompleteEarly()
+{
+	auto parser = IncrementalParser();
+
+	assert(parser.feed("[1, 2"));
+	assert(!parser.next());
+	assert(parser.feed("]"));
+	assert(parser.pendingCount() == 1);
+	assert(parser.next()->length() == 2);
+
+	// A number is only complete once something follows it.
+	assert(parser.feed("12"));
+	assert(!parser.next());
+	assert(parser.feed("3 "));
+	assert(parser.next()->integer() == 123);
+}
+
+void testFinish()
+{
+	auto parser = IncrementalParser();
+
+	assert(parser.feed("true"));
+	assert(!parser.next());
+	assert(parser.finish());
+	assert(parser.next()->boolean());
+
+	auto incomplete = IncrementalParser();
+
+	assert(incomplete.feed("{\"a\": \"b"));
+	assert(!incomplete.finish());
+	assert(incomplete.isFailed());
+}
+
+void testInvalid()
+{
+	auto parser = IncrementalParser();
+
+	assert(!parser.feed("]"));
+	assert(parser.isFailed());
+	assert(!parser.feed("1 "));
+
+	auto separated = IncrementalParser();
+
+	assert(!separated.feed("1, 2"));
+
+	auto invalidValue = IncrementalParser();
+
+	assert(invalidValue.feed("[1, "));
+	assert(!invalidValue.feed("2 3]"));
+
+	auto invalidScalar = IncrementalParser();
+
+	assert(!invalidScalar.feed("nul "));
+}
+
+void testLargeValue()
+{
+	// Only the token being received is buffered, so a value far larger than
+	// the token limit is parsed as its chunks arrive.
+	auto options = IncrementalParserOptions();
+
+	options.maxTokenLength = 16;
+
+	auto parser = IncrementalParser(options);
+	auto text = std::string("[");
+
+	assert(parser.feed("{\"items\": ["));
+	assert(parser.depth() == 2);
+
+	for (size_t i = 0; i < 10000; ++i)
+	{
+		auto element = "{\"id\": " + std::to_string(i) + ", \"name\": \"item\"}, ";
+
+		assert(parser.feed(element));
+		text += element;
+	}
+
+	text += "null]";
+
+	assert(parser.feed("null]}"));
+	assert(parser.depth() == 0);
+
+	auto value = parser.next();
+
+	assert(value);
+	assert((*value)["items"] == *deserialize(text));
+}
+
+void testLimits()
+{
+	auto options = IncrementalParserOptions();
+
+	options.maxTokenLength = 8;
+
+	auto parser = IncrementalParser(options);
+
+	assert(parser.feed("\"12345678\" 12345678 \"1234"));
+	assert(parser.pendingCount() == 2);
+	assert(!parser.feed("56789\""));
+
+	auto depthOptions = IncrementalParserOptions();
+
+	depthOptions.maxDepth = 2;
+
+	auto shallow = IncrementalParser(depthOptions);
+
+	assert(shallow.feed("[[1]] "));
+	assert(!shallow.feed("[[["));
+}
+
+void testNestedErrors()
+{
+	// Errors inside values are found as soon as their characters arrive.
+	auto parser = IncrementalParser();
+
+	assert(parser.feed("{\"a\": [1, 2"));
+	assert(!parser.feed("}"));
+
+	auto key = IncrementalParser();
+
+	assert(!key.feed("{1"));
+
+	auto escape = IncrementalParser();
+
+	assert(!escape.feed("[\"a\\q\""));
+
+	auto range = IncrementalParser();
+
+	assert(!range.feed("[1e999,"));
+}
+
+int main()
+{
+	testWhole();
+	testChunks();
+	testValuesCompleteEarly();
+	testFinish();
+	testInvalid();
+	testLargeValue();
+	testLimits();
+	testNestedErrors();
+
+	return 0;
+}
@@ -0,0 +1,63 @@
+#include "hirzel/json/Key.hpp"
+#include "hirzel/json/Deserialization.hpp"
+#include "hirzel/json/Value.hpp"
+
+#include <cassert>
+#include <string>
+
+using namespace hirzel::json;
+using namespace hirzel::json::literals;
+
+void testHash()
+{
+	constexpr auto key = Key("name");
+
+	static_assert(key.text() == "name");
+	static_assert(key.hash() == hashKey("name"));
+	static_assert("name"_key.hash() == key.hash());
+	static_assert(hashKey("name") != hashKey("nome"));
+
+	assert(Key(std::string("name")).hash() == key.hash());
+}
+
+void testLookup()
+{
+	auto value = deserialize(R"({ "id": 7, "name": "abc" })");
+
+	assert(value);
+	assert((*value)["id"_key] == Value(7));
+	assert(value->at(Key("name"))->string() == "abc");
+	assert(!value->at("missing"_key));
+	assert(value->contains("id"_key));
+	assert(!value->contains(Key("ID")));
+
+	// string_view lookups do not need a std::string.
+	auto name = std::string_view("name, with a suffix").substr(0, 4);
+
+	assert((*value)[name].string() == "abc");
+	assert(value->at(std::string("id")));
+	assert(!Value(1).at("id"_key));
+}
+
+void testIndexedLookup()
+{
+	auto object = Object();
+
+	for (int i = 0; i < 100; ++i)
+		object["key" + std::to_string(i)] = i;
+
+	auto value = Value(std::move(object));
+
+	assert(value["key42"_key] == Value(42));
+	assert(value["key99"] == Value(99));
+	assert(!value.at("key100"_key));
+}
+
+int main()
+{
+	testHash();
+	testLookup();
+	testIndexedLookup();
+
+	return 0;
+}
@@ -0,0 +1,102 @@
+#include "hirzel/json/KeyPool.hpp"
+#include "hirzel/json/Deserialization.hpp"
+#include "hirzel/json/ThreadPool.hpp"
+
+#include <cassert>
+#include <string>
+
+using namespace hirzel::json;
+
+void testIntern()
+{
+	auto pool = KeyPool();
+	auto text = std::string("name");
+	auto a = pool.intern(text);
+	auto b = pool.intern("name");
+	auto c = pool.intern("other");
+
+	assert(a == "name");
+	assert(a.data() == b.data());
+	assert(a.data() != text.data());
+	assert(!a.isOwned());
+	assert(c == "other");
+	assert(pool.intern("").isEmpty());
+	assert(pool.size() == 3);
+}
+
+void testThreads()
+{
+	auto pool = KeyPool();
+	auto threads = ThreadPool(4);
+	const char* data[64] = {};
+
+	threads.parallelFor(64, [&](size_t i)
+	{
+		data[i] = pool.intern("key" + std::to_string(i % 8)).data();
+	});
+
+	assert(pool.size() == 8);
+
+	for (size_t i = 8; i < 64; ++i)
+		assert(data[i] == data[i % 8]);
+}
+
+void testSharedPool()
+{
+	auto pool = KeyPool();
+	auto options = DeserializationOptions();
+
+	options.keyPool = &pool;
+
+	auto first = deserialize(R"([{ "id": 1, "name": "a" }, { "id": 2, "name": "b" }])", options);
+	auto second = deserialize(R"({ "name": "c" })", options);
+
+	assert(first && second);
+	assert(pool.size() == 2);
+
+	const auto& records = first->array();
+	const auto* name = records[0].object().begin()[1].first.data();
+
+	assert(records[1].object().begin()[1].first.data() == name);
+	assert(second->object().begin()->first.data() == name);
+	assert((*second)["name"].string() == "c");
+
+	auto parallelOptions = ParallelDeserializationOptions();
+
+	parallelOptions.deserialization = options;
+	parallelOptions.minParallelLength = 0;
+
+	auto parallel = deserializeParallel(R"([{ "name": 1 }, { "name": 2 }, { "id": 3 }])", parallelOptions);
+
+	assert(parallel);
+	assert((*parallel)[1].object().begin()->first.data() == name);
+	assert(pool.size() == 2);
+}
+
+void testDocumentPool()
+{
+	auto options = DeserializationOptions();
+
+	options.internKeys = true;
+
+	auto document = deserializeDocument(R"([{ "key": 1 }, { "key": 2 }])", options);
+
+	assert(document);
+	assert(document->keyPool().size() == 1);
+
+	auto moved = std::move(*document);
+	const auto& records = moved.root().array();
+
+	assert(records[0].object().begin()->first.data() == records[1].object().begin()->first.data());
+	assert(records[1]["key"] == Value(2));
+}
+
+int main()
+{
+	testIntern();
+	testThreads();
+	testSharedPool();
+	testDocumentPool();
+
+	return 0;
+}
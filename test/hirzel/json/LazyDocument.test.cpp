@@ -0,0 +1,157 @@
+#include "hirzel/json/LazyDocument.hpp"
+#include "hirzel/json/Deserialization.hpp"
+
+#include <cassert>
+#include <string>
+
+using namespace hirzel::json;
+
+static const char* const json = R"({
+	"id": 12,
+	"name": "widget",
+	"tags": ["a", "b", { "nested": [1, 2, 3] }],
+	"empty": {},
+	"none": [],
+	"flags": { "active": true, "deleted": false, "owner": null },
+	"price": -1.5e2
+})";
+
+void testNavigation()
+{
+	auto document = LazyDocument::open(json);
+
+	assert(document);
+
+	auto root = document->root();
+
+	assert(root.isObject());
+	assert(root.length() == 7);
+	assert(root.at("id")->value() == Value(12));
+	assert(root.at("name")->string() == "widget");
+	assert(root.at("name")->text() == "\"widget\"");
+	assert(root.at("tags")->length() == 3);
+	assert(root.at("tags")->at(1)->string() == "b");
+	assert(root.at("tags")->at(2)->at("nested")->at(2)->value() == Value(3));
+	assert(!root.at("tags")->at(3));
+	assert(root.at("empty")->length() == 0);
+	assert(root.at("none")->length() == 0);
+	assert(!root.at("none")->at(0));
+	assert(root.at("flags")->at("active")->value() == Value(true));
+	assert(root.at("flags")->at("owner")->isNull());
+	assert(root.at("price")->value()->number() == -150.0);
+	assert(root.at("price")->text() == "-1.5e2");
+	assert(!root.at("missing"));
+	assert(!root.at(0));
+}
+
+void testValue()
+{
+	auto document = LazyDocument::open(json);
+	auto tags = document->root().at("tags");
+
+	assert(tags->text() == R"(["a", "b", { "nested": [1, 2, 3] }])");
+	assert(*tags->value() == *deserialize(R"(["a", "b", { "nested": [1, 2, 3] }])"));
+	assert(*document->root().value() == *deserialize(json));
+}
+
+void testForEach()
+{
+	auto document = LazyDocument::open(json);
+	auto keys = std::string();
+
+	document->root().forEach([&](std::string_view key, const LazyValue& value)
+	{
+		keys += key;
+		keys += value.isObject() ? "{}" : "";
+		keys += ',';
+
+		return key != "flags";
+	});
+
+	assert(keys == "id,name,tags,empty{},none,flags{},");
+}
+
+void testScalarRoot()
+{
+	auto document = LazyDocument::open("  42  ");
+
+	assert(document);
+	assert(document->root().text() == "42");
+	assert(document->root().value() == Value(42));
+	assert(LazyDocument::open("\"text\"")->root().string() == "text");
+}
+
+void testInvalid()
+{
+	assert(!LazyDocument::open(""));
+	assert(!LazyDocument::open("[1, 2"));
+	assert(!LazyDocument::open("[1, 2}"));
+	assert(!LazyDocument::open("{ \"a\": 1 }]"));
+	assert(!LazyDocument::open("[1] [2]"));
+	assert(!LazyDocument::open("[\"unterminated]"));
+
+	// Only the brackets are checked when opening.
+	auto document = LazyDocument::open("[1, tru, [2]]");
+
+	assert(document);
+	assert(document->root().at(0)->value() == Value(1));
+	assert(!document->root().at(1)->value());
+	assert(document->root().at(2)->at(0)->value() == Value(2));
+}
+
+void testEscapedKeys()
+{
+	auto document = LazyDocument::open(R"({ "a\nb": 1, "\u0063": 2, "\\": 3, "c": 4 })");
+	auto root = document->root();
+
+	assert(root.at("a\nb")->value() == Value(1));
+	assert(root.at("c")->value() == Value(2));
+	assert(root.at("\\")->value() == Value(3));
+	assert(!root.at("\\u0063"));
+}
+
+void testInvalidStructure()
+{
+	// The brackets are balanced, but the punctuation between them is not
+	// checked until the container is visited.
+	for (auto json : { "[1 2]", "[1, , 2]", "[1, ]", "{ \"a\" 1 }", "{ \"a\": 1 \"b\": 2 }", "{ 1: 2 }", "{ \"a\": 1, }" })
+	{
+		auto document = LazyDocument::open(json);
+		auto error = ParseError();
+		size_t count = 0;
+
+		assert(document);
+		assert(!document->root().forEach([&](std::string_view, const LazyValue&)
+		{
+			count += 1;
+			return true;
+		}, &error));
+		assert(error.code() == ErrorCode::UnexpectedToken);
+		assert(!document->root().at(5));
+		assert(!document->root().at("b"));
+	}
+
+	auto document = LazyDocument::open("{ \"a\": 1 \"b\": 2 }");
+	auto error = ParseError();
+
+	assert(!document->root().forEach([](std::string_view, const LazyValue&) { return true; }, &error));
+	assert(error.offset() == 9);
+	assert(error.text() == "\"");
+	assert(std::string(error.detail()) == "',' or '}'");
+
+	// Stopping early is not a failure.
+	assert(document->root().forEach([](std::string_view, const LazyValue&) { return false; }));
+}
+
+int main()
+{
+	testNavigation();
+	testValue();
+	testForEach();
+	testScalarRoot();
+	testInvalid();
+	testEscapedKeys();
+	testInvalidStructure();
+
+	return 0;
+}
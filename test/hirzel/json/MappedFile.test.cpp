@@ -0,0 +1,124 @@
+#include "hirzel/json/Deserialization.hpp"
+#include "hirzel/json/MappedFile.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+using namespace hirzel::json;
+
+std::string createFile(const char* text)
+{
+	char path[] = "/tmp/hirzel-json-XXXXXX";
+	auto fd = mkstemp(path);
+
+	assert(fd >= 0);
+
+	auto length = strlen(text);
+
+	assert(write(fd, text, length) == (ssize_t)length);
+	close(fd);
+
+	return path;
+}
+
+bool isInside(const char* ptr, const MappedFile& file)
+{
+	return ptr >= file.data() && ptr < file.data() + file.length();
+}
+
+void testOpen()
+{
+	auto path = createFile("[1, 2, 3]");
+	auto file = MappedFile::open(path.c_str());
+
+	assert(file);
+	assert(file->view() == "[1, 2, 3]");
+
+	auto moved = std::move(*file);
+
+	assert(moved.view() == "[1, 2, 3]");
+	assert(file->length() == 0);
+
+	unlink(path.c_str());
+}
+
+void testOpenInvalid()
+{
+	assert(!MappedFile::open("/tmp/hirzel-json-does-not-exist"));
+	assert(!MappedFile::open("/tmp"));
+
+	auto error = ParseError();
+
+	assert(!MappedFile::open("/tmp/hirzel-json-does-not-exist", &error));
+	assert(error.code() == ErrorCode::FileError);
+	assert(std::string(error.detail()) == "No such file or directory.");
+	assert(error.message() == "Unable to map file '/tmp/hirzel-json-does-not-exist': No such file or directory.");
+	assert(!MappedFile::open("/tmp", &error));
+	assert(std::string(error.detail()) == "Not a regular file.");
+}
+
+void testDeserializeFile()
+{
+	auto path = createFile(R"({ "name": "value", "list": [1, "two"] })");
+	auto document = deserializeFile(path);
+
+	assert(document);
+	assert(!document->source());
+	assert(document->root()["name"].string() == "value");
+	assert(document->root()["list"][1].string() == "two");
+
+	unlink(path.c_str());
+}
+
+void testBorrowedStrings()
+{
+	auto path = createFile(R"({ "name": "a value that is too long to be inline" })");
+	auto options = DeserializationOptions();
+
+	options.borrowStrings = true;
+
+	auto document = deserializeFile(path, options);
+
+	// The file may be removed while it is mapped.
+	unlink(path.c_str());
+
+	assert(document);
+	assert(document->source());
+
+	auto moved = std::move(*document);
+	const auto& name = moved.root()["name"];
+
+	assert(name.string() == "a value that is too long to be inline");
+	assert(isInside(name.string().data(), *moved.source()));
+}
+
+void testInvalidFile()
+{
+	auto path = createFile("[1, 2");
+
+	assert(!deserializeFile(path));
+	assert(!deserializeFile("/tmp/hirzel-json-does-not-exist"));
+
+	unlink(path.c_str());
+
+	auto empty = createFile("");
+
+	assert(!deserializeFile(empty));
+
+	unlink(empty.c_str());
+}
+
+int main()
+{
+	testOpen();
+	testOpenInvalid();
+	testDeserializeFile();
+	testBorrowedStrings();
+	testInvalidFile();
+
+	return 0;
+}
@@ -0,0 +1,238 @@
+#include "hirzel/json/Ndjson.hpp"
+#include "hirzel/json/Error.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hirzel::json;
+
+std::string generateLines(size_t count)
+{
+	auto text = std::string();
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		text += "{\"id\":";
+		text += std::to_string(i);
+		text += ",\"message\":\"line\"}\n";
+	}
+
+	return text;
+}
+
+void testOrdered()
+{
+	auto pool = ThreadPool(4);
+	auto text = generateLines(1000);
+	auto options = NdjsonOptions();
+	auto indices = std::vector<size_t>();
+
+	options.pool = &pool;
+	options.batchSize = 256;
+
+	auto result = readNdjson(text, [&](size_t index, std::optional<Value>&& value)
+	{
+		assert(value);
+		assert((*value)["id"].integer() == (int64_t)index);
+		indices.push_back(index);
+
+		return true;
+	}, options);
+
+	assert(result);
+	assert(indices.size() == 1000);
+	assert(std::is_sorted(indices.begin(), indices.end()));
+}
+
+void testUnordered()
+{
+	auto pool = ThreadPool(4);
+	auto text = generateLines(1000);
+	auto options = NdjsonOptions();
+	auto indices = std::vector<size_t>();
+
+	options.pool = &pool;
+	options.batchSize = 256;
+	options.isOrdered = false;
+
+	assert(readNdjson(text, [&](size_t index, std::optional<Value>&& value)
+	{
+		assert((*value)["id"].integer() == (int64_t)index);
+		indices.push_back(index);
+
+		return true;
+	}, options));
+
+	std::sort(indices.begin(), indices.end());
+
+	for (size_t i = 0; i < indices.size(); ++i)
+		assert(indices[i] == i);
+}
+
+void testBlankAndInvalidLines()
+{
+	const char* text = "[1]\n\n  \r\n{\"a\": }\r\n\"last\"";
+	auto indices = std::vector<size_t>();
+	auto validCount = 0;
+
+	assert(readNdjson(text, [&](size_t index, std::optional<Value>&& value)
+	{
+		indices.push_back(index);
+		validCount += value.has_value();
+
+		return true;
+	}));
+
+	assert(indices == (std::vector<size_t> { 0, 3, 4 }));
+	assert(validCount == 2);
+	assert(readNdjson("", [](size_t, std::optional<Value>&&) { assert(false); return true; }));
+}
+
+void testErrors()
+{
+	auto pool = ThreadPool(4);
+	auto text = generateLines(1000);
+
+	for (auto index : { 700, 300, 301 })
+	{
+		auto position = 0;
+
+		for (auto i = 0; i < index; ++i)
+			position = text.find('\n', position) + 1;
+
+		text.replace(position + index % 3, 1, "@");
+	}
+
+	auto error = ParseError();
+	auto errors = std::vector<std::pair<size_t, ErrorCode>>();
+	auto options = NdjsonOptions();
+
+	options.pool = &pool;
+	options.batchSize = 256;
+	options.isOrdered = false;
+	options.deserialization.error = &error;
+	options.errorCallback = [&](size_t index, const ParseError& error)
+	{
+		errors.emplace_back(index, error.code());
+	};
+
+	assert(readNdjson(text, [&](size_t index, std::optional<Value>&& value)
+	{
+		assert(value.has_value() == (index != 300 && index != 301 && index != 700));
+
+		return true;
+	}, options));
+
+	std::sort(errors.begin(), errors.end());
+
+	assert(errors.size() == 3);
+	assert(errors[0].first == 300);
+	assert(errors[1].first == 301);
+	assert(errors[2].first == 700);
+	assert(error.code() == ErrorCode::InvalidCharacter);
+	assert(error.line() == 1);
+	assert(error.column() == 1);
+}
+
+void testErrorsOnCallingThread()
+{
+	auto pool = ThreadPool(4);
+	auto text = std::string();
+
+	for (size_t i = 0; i < 200; ++i)
+		text += "[1, @]\n";
+
+	auto options = NdjsonOptions();
+	auto callingThread = std::this_thread::get_id();
+	size_t messageCount = 0;
+
+	options.pool = &pool;
+	options.batchSize = 64;
+
+	onError([&](const char*)
+	{
+		assert(std::this_thread::get_id() == callingThread);
+		messageCount += 1;
+	});
+
+	assert(readNdjson(text, [](size_t, std::optional<Value>&& value)
+	{
+		assert(!value);
+
+		return true;
+	}, options));
+
+	onError(nullptr);
+
+	assert(messageCount == 200);
+}
+
+void testThrowingCallback()
+{
+	// Batches in flight refer to the stack of readNdjson, so they are
+	// waited for before an exception leaves it.
+	auto pool = ThreadPool(4);
+	auto text = generateLines(5000);
+	auto options = NdjsonOptions();
+
+	options.pool = &pool;
+	options.batchSize = 128;
+
+	for (auto isOrdered : { true, false })
+	{
+		auto isThrown = false;
+
+		options.isOrdered = isOrdered;
+
+		try
+		{
+			readNdjson(text, [](size_t, std::optional<Value>&&) -> bool
+			{
+				throw std::runtime_error("stop");
+			}, options);
+		}
+		catch (const std::runtime_error&)
+		{
+			isThrown = true;
+		}
+
+		assert(isThrown);
+	}
+}
+
+void testStop()
+{
+	auto pool = ThreadPool(2);
+	auto text = generateLines(1000);
+	auto options = NdjsonOptions();
+	size_t count = 0;
+
+	options.pool = &pool;
+	options.batchSize = 128;
+
+	assert(!readNdjson(text, [&](size_t, std::optional<Value>&&)
+	{
+		count += 1;
+
+		return count < 10;
+	}, options));
+
+	assert(count == 10);
+}
+
+int main()
+{
+	testOrdered();
+	testUnordered();
+	testBlankAndInvalidLines();
+	testErrors();
+	testErrorsOnCallingThread();
+	testThrowingCallback();
+	testStop();
+
+	return 0;
+}
@@ -0,0 +1,145 @@
+#include "hirzel/json/Number.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+using namespace hirzel::json;
+
+void testInteger()
+{
+	assert(parseNumber("0")->isInteger());
+	assert(parseNumber("0")->integer() == 0);
+	assert(parseNumber("123")->integer() == 123);
+	assert(parseNumber("-123")->integer() == -123);
+	assert(parseNumber("9223372036854775807")->integer() == INT64_MAX);
+	assert(parseNumber("-9223372036854775808")->integer() == INT64_MIN);
+	assert(parseNumber("9007199254740993")->integer() == 9007199254740993);
+}
+
+void testNegativeZero()
+{
+	auto value = parseNumber("-0");
+
+	assert(value);
+	assert(!value->isInteger());
+	assert(value->number() == 0.0);
+	assert(std::signbit(value->number()));
+}
+
+void testLargeInteger()
+{
+	auto value = parseNumber("9223372036854775808");
+
+	assert(value);
+	assert(!value->isInteger());
+	assert(value->number() == 9223372036854775808.0);
+	assert(!parseNumber("-9223372036854775809")->isInteger());
+	assert(!parseNumber("12345678901234567890123")->isInteger());
+}
+
+void testDecimal()
+{
+	assert(!parseNumber("1.0")->isInteger());
+	assert(parseNumber("1.0")->number() == 1.0);
+	assert(parseNumber("0.1")->number() == 0.1);
+	assert(parseNumber("-123.456")->number() == -123.456);
+	assert(parseNumber("1e3")->number() == 1000.0);
+	assert(parseNumber("1E+3")->number() == 1000.0);
+	assert(parseNumber("25e-1")->number() == 2.5);
+	assert(parseNumber("2.2250738585072014e-308")->number() == 2.2250738585072014e-308);
+	assert(parseNumber("1.7976931348623157e308")->number() == 1.7976931348623157e308);
+}
+
+void testUnderflow()
+{
+	auto positive = parseNumber("1e-400");
+	auto negative = parseNumber("-1e-400");
+
+	assert(positive && positive->number() == 0.0 && !std::signbit(positive->number()));
+	assert(negative && negative->number() == 0.0 && std::signbit(negative->number()));
+	assert(parseNumber("0.00000000000000000000123e-400")->number() == 0.0);
+	assert(parseNumber("5e-324")->number() == 5e-324);
+	assert(!parseNumber("1e400"));
+	assert(!parseNumber("-1e400"));
+	assert(parseNumber("1000e-100000000000000000000")->number() == 0.0);
+}
+
+void testRoundTrip()
+{
+	// Exactly halfway between two doubles, which rounds to even.
+	assert(parseNumber("9007199254740993.0")->number() == 9007199254740992.0);
+	assert(parseNumber("0.30000000000000004")->number() == 0.1 + 0.2);
+}
+
+void testInvalid()
+{
+	assert(!parseNumber(""));
+	assert(!parseNumber("-"));
+	assert(!parseNumber("abc"));
+	assert(!parseNumber("inf"));
+	assert(!parseNumber("nan"));
+	assert(!parseNumber("12abc"));
+	assert(!parseNumber("1e400"));
+}
+
+std::string format(const Value& value)
+{
+	char buffer[maxNumberLength];
+	auto* end = formatNumber(buffer, value);
+
+	return std::string(buffer, end);
+}
+
+void testFormatInteger()
+{
+	assert(format(Value(0)) == "0");
+	assert(format(Value(123)) == "123");
+	assert(format(Value(-123)) == "-123");
+	assert(format(Value(INT64_MAX)) == "9223372036854775807");
+	assert(format(Value(INT64_MIN)) == "-9223372036854775808");
+	assert(format(Value(123.0)) == "123");
+	assert(format(Value(-0.0)) == "-0");
+}
+
+void testFormatDecimal()
+{
+	assert(format(Value(0.1)) == "0.1");
+	assert(format(Value(0.1 + 0.2)) == "0.30000000000000004");
+	assert(format(Value(-123.456)) == "-123.456");
+	assert(format(Value(1e300)) == "1e+300");
+	assert(format(Value(5e-324)) == "5e-324");
+	assert(format(Value(std::numeric_limits<double>::infinity())) == "null");
+	assert(format(Value(std::numeric_limits<double>::quiet_NaN())) == "null");
+}
+
+void testFormatRoundTrip()
+{
+	const double numbers[] = { 0.1, 1.0 / 3.0, 2.2250738585072014e-308, 1.7976931348623157e308, 9007199254740993.0, 1e21, 123456.789e-10 };
+
+	for (auto number : numbers)
+	{
+		auto text = format(Value(number));
+
+		assert(text.length() < maxNumberLength);
+		assert(parseNumber(text)->number() == number);
+	}
+}
+
+int main()
+{
+	testInteger();
+	testNegativeZero();
+	testLargeInteger();
+	testDecimal();
+	testUnderflow();
+	testRoundTrip();
+	testInvalid();
+	testFormatInteger();
+	testFormatDecimal();
+	testFormatRoundTrip();
+
+	return 0;
+}
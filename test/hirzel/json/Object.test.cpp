@@ -0,0 +1,130 @@
+#include "hirzel/json/Object.hpp"
+#include "hirzel/json/Deserialization.hpp"
+#include "hirzel/json/Serialization.hpp"
+#include "hirzel/json/Value.hpp"
+
+#include <cassert>
+#include <string>
+
+using namespace hirzel::json;
+
+static std::string keyName(size_t i)
+{
+	return "key" + std::to_string(i);
+}
+
+void testInsertionOrder()
+{
+	auto object = Object();
+
+	object["b"] = 1;
+	object["a"] = 2;
+	object["c"] = 3;
+	object["a"] = 4;
+
+	assert(object.size() == 3);
+
+	auto iter = object.begin();
+
+	assert(iter->first == "b");
+	assert((++iter)->first == "a");
+	assert(iter->second == Value(4));
+	assert((++iter)->first == "c");
+	assert(++iter == object.end());
+}
+
+void testEmplace()
+{
+	auto object = Object();
+
+	assert(object.emplace(String("key"), Value(1)).second);
+
+	auto result = object.emplace(String("key"), Value(2));
+
+	assert(!result.second);
+	assert(result.first->second == Value(1));
+	assert(object.size() == 1);
+}
+
+void testLookup()
+{
+	auto object = Object();
+
+	// Crosses the threshold so that both the linear search and the index are
+	// used, and grows the index several times.
+	for (size_t i = 0; i < Object::indexThreshold * 8; ++i)
+	{
+		assert(object.find(keyName(i)) == object.end());
+
+		object[keyName(i)] = (int)i;
+
+		for (size_t j = 0; j <= i; j += 7)
+		{
+			auto iter = object.find(keyName(j));
+
+			assert(iter != object.end());
+			assert(iter->second == Value((int)j));
+		}
+	}
+
+	assert(!object.contains("missing"));
+	assert(object.contains(keyName(0)));
+}
+
+void testErase()
+{
+	auto object = Object();
+
+	for (size_t i = 0; i < Object::indexThreshold + 1; ++i)
+		object[keyName(i)] = (int)i;
+
+	assert(object.erase(keyName(3)) == 1);
+	assert(object.erase(keyName(3)) == 0);
+	assert(!object.contains(keyName(3)));
+	assert(object.find(keyName(4))->second == Value(4));
+	assert((object.begin() + 3)->first == keyName(4));
+
+	assert(object.erase(keyName(0)) == 1);
+	assert(object.size() == Object::indexThreshold - 1);
+	assert(object.find(keyName(Object::indexThreshold))->second == Value((int)Object::indexThreshold));
+
+	object.clear();
+
+	assert(object.empty());
+	assert(!object.contains(keyName(1)));
+}
+
+void testCopy()
+{
+	auto arena = Arena();
+	auto object = Object(arena.resource());
+
+	for (size_t i = 0; i < Object::indexThreshold * 2; ++i)
+		object[keyName(i)] = (int)i;
+
+	auto copy = Object(object);
+
+	assert(copy.get_allocator().resource() == std::pmr::get_default_resource());
+	assert(copy.size() == object.size());
+	assert(copy.find(keyName(20))->second == Value(20));
+	assert(Value(copy) == Value(object));
+}
+
+void testSerializationOrder()
+{
+	const auto* json = R"({"zebra":1,"apple":[true],"mango":{"b":null,"a":"x"}})";
+
+	assert(serialize(*deserialize(json)) == json);
+}
+
+int main()
+{
+	testInsertionOrder();
+	testEmplace();
+	testLookup();
+	testErase();
+	testCopy();
+	testSerializationOrder();
+
+	return 0;
+}
@@ -0,0 +1,266 @@
+#include "hirzel/json/ParseError.hpp"
+#include "hirzel/json/Deserialization.hpp"
+#include "hirzel/json/Error.hpp"
+#include "hirzel/json/IncrementalParser.hpp"
+#include "hirzel/json/LazyDocument.hpp"
+#include "hirzel/json/Pointer.hpp"
+#include "hirzel/json/Reader.hpp"
+#include "hirzel/json/ThreadPool.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hirzel::json;
+
+static ParseError parseError(std::string_view json)
+{
+	auto error = ParseError();
+	auto options = DeserializationOptions();
+
+	options.error = &error;
+
+	assert(!deserialize(json, options));
+	assert(error);
+
+	return error;
+}
+
+void testCodes()
+{
+	assert(parseError("[1, @]").code() == ErrorCode::InvalidCharacter);
+	assert(parseError("[true @]").code() == ErrorCode::InvalidCharacter);
+	assert(parseError("[true @]").offset() == 6);
+	assert(parseError("[null @]").code() == ErrorCode::InvalidCharacter);
+	assert(parseError("[\"abc").code() == ErrorCode::UnterminatedString);
+	assert(parseError("[\"ab\\q\"]").code() == ErrorCode::InvalidString);
+	assert(parseError("[\"ab\\q\"]").offset() == 4);
+	assert(parseError("[1.]").code() == ErrorCode::InvalidNumber);
+	assert(parseError("[nul]").code() == ErrorCode::InvalidKeyword);
+	assert(parseError("{\"a\" 1}").code() == ErrorCode::UnexpectedToken);
+	assert(parseError("[1e999]").code() == ErrorCode::NumberOutOfRange);
+	assert(parseError(std::string(2000, '[')).code() == ErrorCode::DepthExceeded);
+}
+
+void testLocation()
+{
+	auto error = parseError("{\n\t\"a\": 1,\n\t\"b\" true\n}");
+
+	assert(error.code() == ErrorCode::UnexpectedToken);
+	assert(error.offset() == 16);
+	assert(error.line() == 3);
+	assert(error.column() == 6);
+	assert(error.text() == "true");
+	assert(std::string(error.detail()) == "':'");
+	assert(error.message() == "Unable to parse JSON at line 3, column 6: Expected ':', but got 'true'.");
+
+	error.detachSource();
+
+	assert(error.line() == 3);
+	assert(error.column() == 6);
+	assert(error.text().empty());
+
+	auto first = parseError("[1, 2] x");
+
+	assert(first.line() == 1);
+	assert(first.column() == 8);
+}
+
+void testCallback()
+{
+	auto messages = std::vector<std::string>();
+
+	onError([&](const char* message)
+	{
+		messages.push_back(message);
+	});
+
+	// The callback is only used when the caller did not ask for the error.
+	parseError("[1, 2");
+
+	assert(messages.empty());
+	assert(!deserialize("[1, 2"));
+	assert(messages.size() == 1);
+	assert(messages[0] == "Unable to parse JSON at line 1, column 6: Expected ']', but got ''.");
+
+	onError(nullptr);
+}
+
+void testSuccess()
+{
+	auto error = ParseError();
+	auto options = DeserializationOptions();
+
+	options.error = &error;
+
+	assert(deserialize("{\"a\": [1, 2]}", options));
+	assert(deserializeDocument("[true]", options));
+	assert(!error);
+	assert(error.code() == ErrorCode::None);
+}
+
+void testParallel()
+{
+	auto text = std::string("[");
+
+	for (size_t i = 0; i < 200; ++i)
+		text += i == 150 ? "{\"a\": tru}, " : "{\"a\": true}, ";
+
+	text += "1]";
+
+	auto pool = ThreadPool(4);
+	auto error = ParseError();
+	auto options = ParallelDeserializationOptions();
+
+	options.pool = &pool;
+	options.minParallelLength = 0;
+	options.deserialization.error = &error;
+
+	assert(!deserializeParallel(text, options));
+	assert(error.code() == ErrorCode::InvalidKeyword);
+	assert(error.text() == "tru");
+	assert(error.offset() == text.find("tru}"));
+
+	// Without an error to record into, only the earliest error is passed
+	// to the callback, on the calling thread.
+	auto failing = std::string("[");
+
+	for (size_t i = 0; i < 200; ++i)
+		failing += "{\"a\": tru}, ";
+
+	failing += "1]";
+
+	auto callingThread = std::this_thread::get_id();
+	auto messages = std::vector<std::string>();
+
+	options.deserialization.error = nullptr;
+
+	onError([&](const char* message)
+	{
+		assert(std::this_thread::get_id() == callingThread);
+		messages.push_back(message);
+	});
+
+	assert(!deserializeParallel(failing, options));
+	assert(messages.size() == 1);
+	assert(messages[0].find("column 8:") != std::string::npos);
+
+	onError(nullptr);
+}
+
+static ParseError readError(std::string_view json)
+{
+	auto error = ParseError();
+	auto reader = Reader(json.data(), json.length(), &error);
+
+	while (true)
+	{
+		auto event = reader.next();
+
+		assert(!event || event->type() != EventType::EndOfFile);
+
+		if (!event)
+			break;
+	}
+
+	assert(error);
+
+	return error;
+}
+
+void testEntryPoints()
+{
+	auto messages = std::vector<std::string>();
+
+	onError([&](const char* message)
+	{
+		messages.push_back(message);
+	});
+
+	auto error = ParseError();
+	auto options = DeserializationOptions();
+
+	options.error = &error;
+
+	assert(!deserializeFile("does/not/exist.json", options));
+	assert(error.code() == ErrorCode::FileError);
+	assert(error.text() == "does/not/exist.json");
+	assert(error.message().find("'does/not/exist.json'") != std::string::npos);
+
+	assert(readError("[1 2]").code() == ErrorCode::UnexpectedToken);
+	assert(readError("[1 2]").offset() == 3);
+	assert(readError("[1e999]").code() == ErrorCode::NumberOutOfRange);
+	assert(readError("[@]").code() == ErrorCode::InvalidCharacter);
+
+	error = ParseError();
+	assert(!LazyDocument::open("[1, 2", &error));
+	assert(error.code() == ErrorCode::UnbalancedBrackets);
+	assert(error.offset() == 0);
+	assert(!LazyDocument::open("[1, 2]]", &error));
+	assert(error.code() == ErrorCode::UnbalancedBrackets);
+	assert(error.offset() == 6);
+	assert(!LazyDocument::open("[1] 2", &error));
+	assert(error.code() == ErrorCode::UnexpectedToken);
+	assert(error.offset() == 4);
+	assert(!LazyDocument::open("// comment\n1", &error));
+	assert(error.code() == ErrorCode::Unindexable);
+
+	assert(!Pointer::parse("/a~2", &error));
+	assert(error.code() == ErrorCode::InvalidPointer);
+	assert(error.offset() == 2);
+	assert(error.message() == "Unable to parse JSON pointer '/a~2' at index 2: Expected '0' or '1' after '~'.");
+
+	auto parserOptions = IncrementalParserOptions();
+
+	parserOptions.error = &error;
+
+	auto parser = IncrementalParser(parserOptions);
+
+	assert(parser.feed("[1]\n  {\"a\": "));
+	assert(!parser.feed("tru}"));
+	assert(error.code() == ErrorCode::InvalidKeyword);
+	assert(error.offset() == 12);
+	assert(error.line() == 2);
+	assert(error.column() == 9);
+
+	// None of the errors were passed to the callback.
+	assert(messages.empty());
+
+	onError(nullptr);
+}
+
+void testThreads()
+{
+	// Each parse records its own error, so threads do not interfere.
+	auto pool = ThreadPool(4);
+	auto failures = std::atomic<size_t>(0);
+
+	pool.parallelFor(64, [&](size_t i)
+	{
+		auto text = std::string(i % 10, ' ') + "[" + std::to_string(i) + ",]";
+		auto error = ParseError();
+		auto options = DeserializationOptions();
+
+		options.error = &error;
+
+		if (!deserialize(text, options) && error.column() == i % 10 + 2 + std::to_string(i).length() + 1)
+			failures += 1;
+	});
+
+	assert(failures == 64);
+}
+
+int main()
+{
+	testCodes();
+	testLocation();
+	testCallback();
+	testSuccess();
+	testParallel();
+	testEntryPoints();
+	testThreads();
+
+	return 0;
+}
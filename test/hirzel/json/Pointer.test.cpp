@@ -0,0 +1,101 @@
+#include "hirzel/json/Pointer.hpp"
+#include "hirzel/json/Deserialization.hpp"
+#include "hirzel/json/Error.hpp"
+
+#include <cassert>
+#include <string>
+
+using namespace hirzel::json;
+
+// The example document of RFC 6901, section 5.
+static const char* const example = R"({
+	"foo": ["bar", "baz"],
+	"": 0,
+	"a/b": 1,
+	"c%d": 2,
+	"e^f": 3,
+	"g|h": 4,
+	"i\\j": 5,
+	"k\"l": 6,
+	" ": 7,
+	"m~n": 8
+})";
+
+void testExample()
+{
+	auto value = deserialize(example);
+
+	assert(value);
+	assert(resolve(*value, "") == &*value);
+	assert(*resolve(*value, "/foo") == (*value)["foo"]);
+	assert(resolve(*value, "/foo/0")->string() == "bar");
+	assert(*resolve(*value, "/") == Value(0));
+	assert(*resolve(*value, "/a~1b") == Value(1));
+	assert(*resolve(*value, "/c%d") == Value(2));
+	assert(*resolve(*value, "/e^f") == Value(3));
+	assert(*resolve(*value, "/g|h") == Value(4));
+	assert(*resolve(*value, "/ ") == Value(7));
+	assert(*resolve(*value, "/m~0n") == Value(8));
+}
+
+void testMissing()
+{
+	auto value = deserialize(R"({ "list": [1, 2], "number": 3 })");
+
+	assert(value);
+	assert(!resolve(*value, "/missing"));
+	assert(!resolve(*value, "/list/2"));
+	assert(!resolve(*value, "/list/-"));
+	assert(!resolve(*value, "/list/01"));
+	assert(!resolve(*value, "/list/one"));
+	assert(!resolve(*value, "/number/0"));
+	assert(*resolve(*value, "/list/1") == Value(2));
+}
+
+void testInvalid()
+{
+	auto errorCount = 0;
+
+	onError([&](const char*)
+	{
+		errorCount += 1;
+	});
+
+	assert(!Pointer::parse("foo"));
+	assert(!Pointer::parse("/a~2"));
+	assert(!Pointer::parse("/a~"));
+	assert(errorCount == 3);
+
+	onError(nullptr);
+}
+
+void testCompiled()
+{
+	auto pointer = Pointer::parse("/users/1/a~1b");
+
+	assert(pointer);
+	assert(pointer->size() == 3);
+	assert(pointer->token(0) == "users");
+	assert(pointer->token(2) == "a/b");
+
+	auto first = deserialize(R"({ "users": [{}, { "a/b": "x" }] })");
+	auto second = deserialize(R"({ "users": [{}, { "a/b": "y" }] })");
+	auto copy = *pointer;
+
+	assert(pointer->resolve(*first)->string() == "x");
+	assert(copy.resolve(*second)->string() == "y");
+
+	*pointer->resolve(*first) = Value("z");
+
+	assert((*first)["users"][1]["a/b"].string() == "z");
+}
+
+int main()
+{
+	testExample();
+	testMissing();
+	testInvalid();
+	testCompiled();
+
+	return 0;
+}
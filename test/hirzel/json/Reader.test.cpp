@@ -0,0 +1,208 @@
+#include "hirzel/json/Reader.hpp"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+using namespace hirzel::json;
+
+std::vector<EventType> readEventTypes(const char* json)
+{
+	auto reader = Reader(json);
+	auto eventTypes = std::vector<EventType>();
+
+	while (true)
+	{
+		auto event = reader.next();
+
+		if (!event)
+			return {};
+
+		eventTypes.push_back(event->type());
+
+		if (event->type() == EventType::EndOfFile)
+			return eventTypes;
+	}
+}
+
+void testScalars()
+{
+	assert(readEventTypes("null") == (std::vector<EventType> { EventType::Null, EventType::EndOfFile }));
+	assert(readEventTypes("true") == (std::vector<EventType> { EventType::Boolean, EventType::EndOfFile }));
+	assert(readEventTypes("123") == (std::vector<EventType> { EventType::Number, EventType::EndOfFile }));
+	assert(readEventTypes("\"abc\"") == (std::vector<EventType> { EventType::String, EventType::EndOfFile }));
+}
+
+void testEmptyContainers()
+{
+	assert(readEventTypes("{}") == (std::vector<EventType> { EventType::StartObject, EventType::EndObject, EventType::EndOfFile }));
+	assert(readEventTypes("[]") == (std::vector<EventType> { EventType::StartArray, EventType::EndArray, EventType::EndOfFile }));
+}
+
+void testPull()
+{
+	auto reader = Reader(R"({ "id": 12, "tags": ["a", false, null], "ratio": 0.5 })");
+
+	auto event = reader.next();
+	assert(event->type() == EventType::StartObject);
+	assert(reader.depth() == 1);
+
+	event = reader.next();
+	assert(event->type() == EventType::Key);
+	assert(event->text() == "id");
+
+	event = reader.next();
+	assert(event->type() == EventType::Number);
+	assert(event->isInteger());
+	assert(event->integer() == 12);
+
+	event = reader.next();
+	assert(event->type() == EventType::Key);
+	assert(event->text() == "tags");
+
+	assert(reader.next()->type() == EventType::StartArray);
+	assert(reader.depth() == 2);
+
+	event = reader.next();
+	assert(event->type() == EventType::String);
+	assert(event->text() == "a");
+
+	event = reader.next();
+	assert(event->type() == EventType::Boolean);
+	assert(event->boolean() == false);
+
+	assert(reader.next()->type() == EventType::Null);
+	assert(reader.next()->type() == EventType::EndArray);
+	assert(reader.depth() == 1);
+
+	event = reader.next();
+	assert(event->type() == EventType::Key);
+	assert(event->text() == "ratio");
+
+	event = reader.next();
+	assert(event->type() == EventType::Number);
+	assert(!event->isInteger());
+	assert(event->number() == 0.5);
+
+	assert(reader.next()->type() == EventType::EndObject);
+	assert(reader.depth() == 0);
+	assert(reader.next()->type() == EventType::EndOfFile);
+	assert(reader.next()->type() == EventType::EndOfFile);
+}
+
+struct SumHandler: public Handler
+{
+	std::vector<std::string> keys;
+	int64_t sum = 0;
+	size_t maxDepth = 0;
+	size_t depth = 0;
+
+	bool startObject() override { depth += 1; maxDepth = std::max(maxDepth, depth); return true; }
+	bool endObject() override { depth -= 1; return true; }
+	bool startArray() override { depth += 1; maxDepth = std::max(maxDepth, depth); return true; }
+	bool endArray() override { depth -= 1; return true; }
+	bool key(std::string_view key) override { keys.emplace_back(key); return true; }
+	bool number(const Value& number) override { sum += number.integer(); return true; }
+};
+
+void testPush()
+{
+	auto handler = SumHandler();
+
+	assert(read(R"({ "a": [1, 2, [3]], "b": { "c": 4 } })", handler));
+	assert(handler.sum == 10);
+	assert(handler.maxDepth == 3);
+	assert(handler.depth == 0);
+	assert(handler.keys == (std::vector<std::string> { "a", "b", "c" }));
+}
+
+struct StopHandler: public Handler
+{
+	size_t count = 0;
+
+	bool number(const Value&) override
+	{
+		count += 1;
+
+		return count < 2;
+	}
+};
+
+void testStop()
+{
+	auto handler = StopHandler();
+
+	assert(!read("[1, 2, 3, 4]", handler));
+	assert(handler.count == 2);
+}
+
+void testInvalid()
+{
+	auto handler = Handler();
+
+	assert(!read("", handler));
+	assert(!read("[1, 2", handler));
+	assert(!read("[1 2]", handler));
+	assert(!read("[1, 2}", handler));
+	assert(!read("{\"a\" 1}", handler));
+	assert(!read("{1: 2}", handler));
+	assert(!read("{\"a\": 1,}", handler));
+	assert(!read("[1] 2", handler));
+	assert(!read("1e400", handler));
+	assert(readEventTypes("[1,").empty());
+
+	auto reader = Reader("[}");
+
+	assert(reader.next()->type() == EventType::StartArray);
+	assert(!reader.next());
+	assert(!reader.next());
+}
+
+void testEscapes()
+{
+	auto reader = Reader(R"({ "a\tb": "x\u00e9\"y", "plain": "z" })");
+
+	assert(reader.next()->type() == EventType::StartObject);
+	assert(reader.next()->text() == "a\tb");
+	assert(reader.next()->text() == "x\xc3\xa9\"y");
+	assert(reader.next()->text() == "plain");
+	assert(reader.next()->text() == "z");
+
+	// Reading fails where deserialization does.
+	auto handler = Handler();
+	auto error = ParseError();
+
+	assert(!read(R"(["a\x"])", handler, &error));
+	assert(error.code() == ErrorCode::InvalidString);
+	assert(error.offset() == 3);
+	assert(!read(R"({"\ud800": 1})", handler, &error));
+	assert(error.code() == ErrorCode::InvalidString);
+}
+
+void testLength()
+{
+	auto handler = SumHandler();
+
+	assert(read("[1, 2]3", 6, handler));
+	assert(handler.sum == 3);
+	assert(!read("[1, 2]3", 5, handler));
+
+	auto reader = Reader("123", 2);
+
+	assert(reader.next()->integer() == 12);
+	assert(reader.next()->type() == EventType::EndOfFile);
+}
+
+int main()
+{
+	testScalars();
+	testEmptyContainers();
+	testPull();
+	testPush();
+	testStop();
+	testInvalid();
+	testEscapes();
+	testLength();
+
+	return 0;
+}
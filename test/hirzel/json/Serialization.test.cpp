@@ -1,6 +1,9 @@
 #include "hirzel/json/Serialization.hpp"
 
 #include <cassert>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 using namespace hirzel::json;
 
@@ -23,8 +26,10 @@ void testNull()
 
 void testNumber()
 {
-	assert(confirmSerialization(Value(123), "123.000000"));
-	assert(confirmSerialization(Value(123.456), "123.456000"));
+	assert(confirmSerialization(Value(123), "123"));
+	assert(confirmSerialization(Value(123.456), "123.456"));
+	assert(confirmSerialization(Value(-0.5), "-0.5"));
+	assert(confirmSerialization(Value(1e300), "1e+300"));
 }
 
 void testBoolean()
@@ -36,19 +41,64 @@ void testBoolean()
 void testString()
 {
 	assert(confirmSerialization(Value("abc"), "\"abc\""));
+	assert(confirmSerialization(Value("say \"hi\"\\\n\t"), R"("say \"hi\"\\\n\t")"));
+	assert(confirmSerialization(Value(std::string("\x01\x1f\0", 3)), R"("\u0001\u001f\u0000")"));
+	assert(confirmSerialization(Value("a/b \xc3\xa9"), "\"a/b \xc3\xa9\""));
+
+	auto object = Object();
+
+	object["key \"quoted\""] = 1;
+
+	assert(confirmSerialization(Value(object), R"({"key \"quoted\"":1})"));
 }
 
 void testArray()
 {
-	assert(confirmSerialization(Value::from(std::vector<int> { 1, 2, 3 }), "[1.000000,2.000000,3.000000]"));
+	assert(confirmSerialization(Value::from(std::vector<int> { 1, 2, 3 }), "[1,2,3]"));
 }
 
 void testObject()
 {
-	assert(confirmSerialization(Value::from(std::unordered_map<std::string, bool> {
-		{ "yes", true },
-		{ "no", false }
-	}), "{\"yes\":true,\"no\":false}"));
+	auto object = Object();
+
+	object["yes"] = true;
+	object["no"] = false;
+
+	assert(confirmSerialization(Value(std::move(object)), "{\"yes\":true,\"no\":false}"));
+	assert(confirmSerialization(Value(ValueType::Object), "{}"));
+}
+
+void testParallel()
+{
+	auto pool = ThreadPool(4);
+	auto options = SerializationOptions();
+
+	options.pool = &pool;
+	options.minParallelLength = 2;
+
+	auto numbers = std::vector<int>();
+	auto fields = std::unordered_map<std::string, int>();
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		numbers.push_back(i);
+		fields["field" + std::to_string(i)] = i;
+	}
+
+	auto array = Value::from(numbers);
+	auto object = Value::from(fields);
+	auto nested = Value::from(std::vector<Value> { array, object, Value(), array });
+
+	assert(serialize(array, options) == serialize(array));
+	assert(serialize(object, options) == serialize(object));
+	assert(serialize(nested, options) == serialize(nested));
+	assert(serialize(Value::from(std::vector<int> { 1 }), options) == "[1]");
+	assert(serialize(Value::from(std::vector<int>()), options) == "[]");
+
+	auto writer = StringWriter();
+
+	assert(serialize(nested, writer, options));
+	assert(writer.release() == serialize(nested));
 }
 
 int main()
@@ -59,6 +109,7 @@ int main()
 	testString();
 	testArray();
 	testObject();
+	testParallel();
 
 	return 0;
 }
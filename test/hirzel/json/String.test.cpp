@@ -0,0 +1,113 @@
+#include "hirzel/json/String.hpp"
+
+#include <cassert>
+
+using namespace hirzel::json;
+
+void testEmpty()
+{
+	auto text = String();
+
+	assert(text.isEmpty());
+	assert(text.length() == 0);
+	assert(text.view() == "");
+	assert(!text.isOwned());
+}
+
+void testOwned()
+{
+	auto text = String("abc");
+
+	assert(text.isOwned());
+	assert(text.length() == 3);
+	assert(text.view() == "abc");
+	assert(String(std::string("hello")).view() == "hello");
+}
+
+void testArena()
+{
+	auto arena = Arena();
+	auto text = String("abc", arena);
+
+	assert(!text.isOwned());
+	assert(text.view() == "abc");
+
+	auto copy = String(text);
+
+	assert(copy.isOwned());
+	assert(copy.view() == "abc");
+	assert(copy.data() != text.data());
+}
+
+void testBorrow()
+{
+	const char* source = "abcdef";
+	auto text = String::borrow(std::string_view(source + 1, 3));
+
+	assert(!text.isOwned());
+	assert(text.data() == source + 1);
+	assert(text.view() == "bcd");
+
+	auto copy = String(text);
+
+	assert(copy.isOwned());
+	assert(copy.data() != text.data());
+	assert(copy.view() == "bcd");
+}
+
+void testComparison()
+{
+	auto text = String("abc");
+
+	assert(text == String::borrow("abc"));
+	assert(text == "abc");
+	assert("abc" == text);
+	assert(text == std::string("abc"));
+	assert(text == std::string_view("abc"));
+	assert(text != "abd");
+	assert(text != String("ab"));
+	assert(std::hash<String>()(text) == std::hash<String>()(String::borrow("abc")));
+}
+
+void testMove()
+{
+	auto text = String("abc");
+	const auto* data = text.data();
+	auto moved = String(std::move(text));
+
+	assert(moved.data() == data);
+	assert(moved.view() == "abc");
+	assert(text.isEmpty());
+}
+
+void testAssignment()
+{
+	auto text = String("abc");
+	auto other = String("defg");
+
+	text = other;
+
+	assert(text.view() == "defg");
+	assert(text.data() != other.data());
+
+	text = String("hij");
+
+	assert(text.view() == "hij");
+
+	text = text;
+
+	assert(text.view() == "hij");
+}
+
+int main()
+{
+	testEmpty();
+	testOwned();
+	testArena();
+	testBorrow();
+	testComparison();
+	testMove();
+	testAssignment();
+
+	return 0;
+}
@@ -0,0 +1,154 @@
+#include "hirzel/json/StructuralIndex.hpp"
+#include "hirzel/json/Token.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace hirzel::json;
+
+const ScannerType scannerTypes[] = { ScannerType::Scalar, ScannerType::Sse42, ScannerType::Avx2 };
+
+std::vector<uint32_t> tokenPositions(const char* src)
+{
+	auto positions = std::vector<uint32_t>();
+	auto token = Token::parse(src);
+
+	while (token && token->type() != TokenType::EndOfFile)
+	{
+		positions.push_back((uint32_t)token->index());
+
+		if (token->type() == TokenType::String)
+			positions.push_back((uint32_t)(token->index() + token->length() - 1));
+
+		token = token->parseNext();
+	}
+
+	assert(token);
+
+	return positions;
+}
+
+bool confirmIndex(const std::string& src, const std::vector<uint32_t>& expected)
+{
+	auto success = true;
+
+	for (auto scannerType : scannerTypes)
+	{
+		if (!isScannerSupported(scannerType))
+			continue;
+
+		auto index = StructuralIndex::build(src.c_str(), src.length(), scannerType);
+
+		if (!index)
+		{
+			std::cerr << scannerTypeName(scannerType) << ": failed to build index\n";
+			success = false;
+			continue;
+		}
+
+		if (index->positions() != expected)
+		{
+			std::cerr << scannerTypeName(scannerType) << ": incorrect positions for " << src << "\n";
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+bool confirmUnindexable(const std::string& src)
+{
+	for (auto scannerType : scannerTypes)
+	{
+		if (isScannerSupported(scannerType) && StructuralIndex::build(src.c_str(), src.length(), scannerType))
+			return false;
+	}
+
+	return true;
+}
+
+void testEmpty()
+{
+	assert(confirmIndex("", {}));
+	assert(confirmIndex("   \n\t ", {}));
+}
+
+void testScalars()
+{
+	assert(confirmIndex("123", { 0 }));
+	assert(confirmIndex("  true ", { 2 }));
+	assert(confirmIndex("[1,-2.5e3,null]", { 0, 1, 2, 3, 9, 10, 14 }));
+}
+
+void testStrings()
+{
+	assert(confirmIndex("\"abc\"", { 0, 4 }));
+	assert(confirmIndex("\"a{b]c,:\"", { 0, 8 }));
+	assert(confirmIndex(R"(["a\"b", "c\\"])", { 0, 1, 6, 7, 9, 13, 14 }));
+	assert(confirmIndex(R"("a\\\"b")", { 0, 7 }));
+}
+
+void testUnindexable()
+{
+	assert(confirmUnindexable("[1, // comment\n 2]"));
+	assert(confirmUnindexable("[1, /* comment */ 2]"));
+	assert(confirmUnindexable("\"unterminated"));
+	assert(confirmUnindexable("\"escaped end\\\""));
+}
+
+void testBlockBoundaries()
+{
+	// Strings, escapes and scalars that straddle the 64 byte blocks.
+	for (size_t padding = 0; padding < 130; ++padding)
+	{
+		auto src = std::string(padding, ' ');
+
+		src += R"({"key\"with\\escapes": [12345, "value", true, false, null, {"a": -1.5}], "x": "\\"})";
+
+		assert(confirmIndex(src, tokenPositions(src.c_str())));
+	}
+}
+
+void testLongDocument()
+{
+	auto src = std::string("[");
+
+	for (size_t i = 0; i < 2000; ++i)
+	{
+		if (i > 0)
+			src += i % 3 ? "," : " ,\n\t";
+
+		src += i % 2
+			? "{\"id\": " + std::to_string(i * 7919) + ", \"name\": \"item \\\"" + std::to_string(i) + "\\\"\"}"
+			: "[" + std::to_string(i) + ".25, true]";
+	}
+
+	src += "]";
+
+	assert(confirmIndex(src, tokenPositions(src.c_str())));
+}
+
+void testScannerTypes()
+{
+	assert(isScannerSupported(ScannerType::Scalar));
+	assert(isScannerSupported(bestScannerType()));
+	assert(!strcmp(scannerTypeName(ScannerType::Scalar), "scalar"));
+	assert(!strcmp(scannerTypeName(ScannerType::Sse42), "sse4.2"));
+	assert(!strcmp(scannerTypeName(ScannerType::Avx2), "avx2"));
+}
+
+int main()
+{
+	testEmpty();
+	testScalars();
+	testStrings();
+	testUnindexable();
+	testBlockBoundaries();
+	testLongDocument();
+	testScannerTypes();
+
+	return 0;
+}
@@ -0,0 +1,72 @@
+#include "hirzel/json/ThreadPool.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <vector>
+
+using namespace hirzel::json;
+
+void testSubmit()
+{
+	auto counter = std::atomic<size_t>(0);
+
+	{
+		auto pool = ThreadPool(4);
+
+		assert(pool.threadCount() == 4);
+
+		for (size_t i = 0; i < 100; ++i)
+			pool.submit([&]() { counter += 1; });
+	}
+
+	// Tasks still queued when the pool is destroyed are run first.
+	assert(counter == 100);
+}
+
+void testParallelFor()
+{
+	auto pool = ThreadPool(4);
+	auto values = std::vector<size_t>(1000, 0);
+
+	pool.parallelFor(values.size(), [&](size_t i)
+	{
+		values[i] = i * 2;
+	});
+
+	for (size_t i = 0; i < values.size(); ++i)
+		assert(values[i] == i * 2);
+
+	pool.parallelFor(0, [](size_t) { assert(false); });
+}
+
+void testNestedParallelFor()
+{
+	auto pool = ThreadPool(2);
+	auto total = std::atomic<size_t>(0);
+
+	pool.parallelFor(8, [&](size_t)
+	{
+		pool.parallelFor(8, [&](size_t)
+		{
+			total += 1;
+		});
+	});
+
+	assert(total == 64);
+}
+
+void testShared()
+{
+	assert(&ThreadPool::shared() == &ThreadPool::shared());
+	assert(ThreadPool::shared().threadCount() > 0);
+}
+
+int main()
+{
+	testSubmit();
+	testParallelFor();
+	testNestedParallelFor();
+	testShared();
+
+	return 0;
+}
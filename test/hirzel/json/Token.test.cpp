@@ -117,6 +117,10 @@ void testNumber()
 {
 	assert(confirmStandaloneToken("123", TokenType::Number));
 	assert(confirmStandaloneToken("123.456", TokenType::Number));
+	assert(confirmStandaloneToken("-1.5e-3", TokenType::Number));
+	assert(confirmStandaloneToken("2E+10", TokenType::Number));
+	assert(!Token::parse("1."));
+	assert(!Token::parse("1e+"));
 }
 
 void testTrue()
@@ -222,6 +226,21 @@ void testText()
 	}));
 }
 
+void testLength()
+{
+	const char* src = "123456";
+	auto token = Token::parse(src, 3);
+
+	assert(confirmToken(token, TokenType::Number, "123", src, 0, 3));
+	assert(confirmToken(token->parseNext(), TokenType::EndOfFile, "", src, 3, 0));
+	assert(!Token::parse("\"abc\"", 4));
+	assert(!Token::parse("true", 3));
+	assert(!Token::parse("1.5", 2));
+	assert(!Token::parse("1e5", 2));
+	assert(Token::parse("  // comment", 12)->type() == TokenType::EndOfFile);
+	assert(!Token::parse(" \0 ", 3));
+}
+
 int main()
 {
 	testString();
@@ -237,6 +256,7 @@ int main()
 	testLeftBrace();
 	testRightBrace();
 	testText();
+	testLength();
 
 	return 0;
 }
@@ -1,5 +1,8 @@
 #include "hirzel/json/Value.hpp"
+#include "hirzel/json/Deserialization.hpp"
+#include "hirzel/json/ThreadPool.hpp"
 #include "hirzel/json/ValueType.hpp"
+#include <cassert>
 #include <unordered_map>
 #include <vector>
 
@@ -48,8 +51,8 @@ void testNull()
 
 void testNumber()
 {
-	assert(confirmValue(Value(1), ValueType::Number, 1, 1.0, true, "1.000000"));
-	assert(confirmValue(Value(123.456), ValueType::Number, 123, 123.456, true, "123.456000"));
+	assert(confirmValue(Value(1), ValueType::Number, 1, 1.0, true, "1"));
+	assert(confirmValue(Value(123.456), ValueType::Number, 123, 123.456, true, "123.456"));
 }
 
 void testBoolean()
@@ -68,16 +71,136 @@ void testString()
 
 void testArray()
 {
-	assert(confirmValue(Value::from(std::vector<int>{ 1, 2, 3 }), ValueType::Array, 0, 0.0, true, "[1.000000,2.000000,3.000000]"));
+	assert(confirmValue(Value::from(std::vector<int>{ 1, 2, 3 }), ValueType::Array, 0, 0.0, true, "[1,2,3]"));
 	assert(confirmValue(Value::from(std::vector<bool>{ true, false, true }), ValueType::Array, 0, 0.0, true, "[true,false,true]"));
 }
 
 void testObject()
 {
-	assert(confirmValue(Value::from(std::unordered_map<std::string, std::string> {
-		{ "first", "abc" },
-		{ "second", "123" }
-	}), ValueType::Object, 0, 0, true, "{\"first\":\"abc\",\"second\":\"123\"}"));
+	// Objects keep their insertion order, so one is built in order rather
+	// than from an unordered_map.
+	auto object = Object();
+
+	object["first"] = "abc";
+	object["second"] = "123";
+
+	assert(confirmValue(Value(std::move(object)), ValueType::Object, 0, 0, true, "{\"first\":\"abc\",\"second\":\"123\"}"));
+	assert(Value::from(std::unordered_map<std::string, int> { { "a", 1 }, { "b", 2 } }).length() == 2);
+}
+
+void testCompactStrings()
+{
+	static_assert(sizeof(Value) == 16);
+
+	const auto* longText = "a string that does not fit inline";
+	auto shortValue = Value("fourteen chars");
+	auto longValue = Value(longText);
+	auto borrowed = Value::borrow(longText);
+	auto borrowedShort = Value::borrow(std::string_view(longText, 8));
+
+	assert(shortValue.string() == "fourteen chars");
+	assert(longValue.string() == longText);
+	assert(longValue.string().data() != longText);
+	assert(borrowed.isBorrowedString());
+	assert(borrowed.string().data() == longText);
+	assert(!borrowedShort.isBorrowedString());
+	assert(borrowedShort.string() == "a string");
+
+	auto copy = Value(borrowed);
+
+	assert(!copy.isBorrowedString());
+	assert(copy == borrowed);
+
+	auto moved = Value(std::move(longValue));
+
+	assert(moved.string() == longText);
+	assert(longValue.isNull());
+
+	auto array = Value::from(std::vector<std::string> { "abc", longText });
+
+	array = array[1];
+
+	assert(array.string() == longText);
+}
+
+void testSharedCopies()
+{
+	auto original = *deserialize(R"([[1, 2], { "x": 1, "y": [true] }, "text"])");
+	auto copy = original;
+	const auto& constOriginal = original;
+	const auto& constCopy = copy;
+
+	assert(original.isShared());
+	assert(copy.isShared());
+	assert(&constOriginal.array() == &constCopy.array());
+
+	// Only the path to the change is cloned.
+	copy[1]["x"] = Value(2);
+
+	assert(!copy.isShared());
+	assert(!copy[1].isShared());
+	assert(constOriginal[1]["x"] == Value(1));
+	assert(constCopy[1]["x"] == Value(2));
+	assert(&constOriginal[0].array() == &constCopy[0].array());
+	assert(&constOriginal[1]["y"].array() == &constCopy[1]["y"].array());
+	assert(constOriginal != constCopy);
+
+	auto assigned = Value();
+
+	assigned = original;
+
+	assert(original.isShared());
+
+	assigned = Value();
+
+	assert(!original.isShared());
+}
+
+void testArenaCopies()
+{
+	auto document = deserializeDocument(R"({ "list": [1, 2, 3] })");
+	auto copy = document->root();
+
+	// Copies do not refer to the document's arena.
+	assert(!copy.isShared());
+	assert(!document->root().isShared());
+	assert(copy == document->root());
+
+	auto second = copy;
+
+	assert(copy.isShared());
+}
+
+void testSharedThreads()
+{
+	const auto config = *deserialize(R"({ "routes": [{ "path": "/a" }, { "path": "/b" }], "limit": 10 })");
+	auto pool = ThreadPool(4);
+
+	pool.parallelFor(64, [&](size_t i)
+	{
+		auto copy = config;
+
+		copy["routes"][i % 2]["path"] = Value((int)i);
+
+		assert(copy["routes"][i % 2]["path"] == Value((int)i));
+		assert(config["routes"][i % 2]["path"].isString());
+	});
+
+	assert(config["routes"][1]["path"].string() == "/b");
+
+	// Copies taken before the threads start share every node until each
+	// thread changes its own.
+	auto copies = std::vector<Value>(256, config);
+
+	pool.parallelFor(copies.size(), [&](size_t i)
+	{
+		copies[i]["limit"] = Value((int)i);
+	});
+
+	for (size_t i = 0; i < copies.size(); ++i)
+		assert(copies[i]["limit"] == Value((int)i));
+
+	assert(config["limit"] == Value(10));
 }
 
 int main()
@@ -88,6 +211,10 @@ int main()
 	testString();
 	testArray();
 	testObject();
+	testCompactStrings();
+	testSharedCopies();
+	testArenaCopies();
+	testSharedThreads();
 
 	return 0;
 }
@@ -0,0 +1,173 @@
+#include "hirzel/json/Serialization.hpp"
+#include "hirzel/json/Writer.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+using namespace hirzel::json;
+
+const Value& sample()
+{
+	static const auto value = Value::from(std::vector<Value> {
+		Value(),
+		Value(1),
+		Value(2.5),
+		Value(true),
+		Value("abc"),
+		Value::from(std::vector<int> { 1, 2, 3 })
+	});
+
+	return value;
+}
+
+const char* sampleText = "[null,1,2.5,true,\"abc\",[1,2,3]]";
+
+void testStringWriter()
+{
+	auto writer = StringWriter(1);
+
+	assert(serialize(sample(), writer));
+	assert(writer.release() == sampleText);
+
+	writer.write("abc", 3);
+
+	assert(writer.release() == "abc");
+	assert(writer.release() == "");
+}
+
+void testStreamWriter()
+{
+	auto out = std::ostringstream();
+
+	{
+		auto writer = StreamWriter(out);
+
+		assert(serialize(sample(), writer));
+	}
+
+	assert(out.str() == sampleText);
+}
+
+void testOutputOperator()
+{
+	auto out = std::ostringstream();
+
+	out << sample() << ' ' << Value("text");
+
+	assert(out.str() == std::string(sampleText) + " text");
+}
+
+void testFileDescriptorWriter()
+{
+	int fds[2];
+
+	assert(pipe(fds) == 0);
+
+	{
+		auto writer = FileDescriptorWriter(fds[1]);
+
+		assert(serialize(sample(), writer));
+	}
+
+	close(fds[1]);
+
+	char buffer[256];
+	auto length = read(fds[0], buffer, sizeof(buffer));
+
+	close(fds[0]);
+
+	assert(length > 0);
+	assert(std::string(buffer, length) == sampleText);
+}
+
+void testSpanWriter()
+{
+	char buffer[64];
+	auto writer = SpanWriter(buffer, sizeof(buffer));
+
+	assert(serialize(sample(), writer));
+	assert(std::string(buffer, writer.length()) == sampleText);
+}
+
+void testSpanWriterOverflow()
+{
+	char buffer[4];
+	auto text = std::string();
+	auto overflowCount = 0;
+	auto writer = SpanWriter(buffer, sizeof(buffer), [&](const char* data, size_t length)
+	{
+		overflowCount += 1;
+		text.append(data, length);
+
+		return true;
+	});
+
+	assert(serialize(sample(), writer));
+	assert(text == sampleText);
+	assert(overflowCount > 1);
+	assert(writer.length() == 0);
+}
+
+void testSpanWriterExactFit()
+{
+	// Numbers fit in whatever space is left, even if it is less than the
+	// longest number needs.
+	char buffer[32];
+	auto length = strlen(sampleText);
+	auto writer = SpanWriter(buffer, length);
+
+	assert(serialize(sample(), writer));
+	assert(!writer.isFailed());
+	assert(std::string(buffer, writer.length()) == sampleText);
+
+	auto single = SpanWriter(buffer, 1);
+
+	assert(serialize(Value(1), single));
+	assert(buffer[0] == '1');
+
+	auto decimal = SpanWriter(buffer, 4);
+
+	assert(serialize(Value(-2.5), decimal));
+	assert(std::string(buffer, decimal.length()) == "-2.5");
+
+	auto tooSmall = SpanWriter(buffer, 3);
+
+	assert(!serialize(Value(-2.5), tooSmall));
+	assert(tooSmall.isFailed());
+}
+
+void testSpanWriterFailure()
+{
+	char buffer[8];
+	auto writer = SpanWriter(buffer, sizeof(buffer));
+
+	assert(!serialize(sample(), writer));
+	assert(writer.isFailed());
+	assert(!writer.write('x'));
+
+	auto rejecting = SpanWriter(buffer, sizeof(buffer), [](const char*, size_t)
+	{
+		return false;
+	});
+
+	assert(!serialize(sample(), rejecting));
+	assert(rejecting.isFailed());
+}
+
+int main()
+{
+	testStringWriter();
+	testStreamWriter();
+	testOutputOperator();
+	testFileDescriptorWriter();
+	testSpanWriter();
+	testSpanWriterOverflow();
+	testSpanWriterExactFit();
+	testSpanWriterFailure();
+
+	return 0;
+}